@@ -0,0 +1,174 @@
+#ifndef ARENA_ALLOCATOR_HPP
+#define ARENA_ALLOCATOR_HPP
+
+#include "Vector.hpp"
+#include <cstdlib>
+#include <cstdint>
+#include <new>
+
+namespace tutorial {
+
+    // monotonic bump allocator. Memory is handed out from large chunks and
+    // only given back all at once by reset(), which rewinds to the first
+    // chunk and keeps the chunks around for reuse. Anything allocated from
+    // the arena must be dead (or never touched again) after reset().
+    class Arena {
+    public:
+        explicit Arena(std::size_t chunk_size = 64*1024);
+        ~Arena();
+
+        Arena(const Arena&) =delete;
+        Arena& operator=(const Arena&) =delete;
+
+        void* allocate(std::size_t bytes, std::size_t align);
+        void deallocate(void* p, std::size_t bytes);
+        bool try_expand(void* p, std::size_t old_bytes, std::size_t new_bytes);
+
+        void reset();
+        void release();
+
+        std::size_t chunk_count() const;
+
+    private:
+        struct Chunk {
+            Chunk* next;
+            std::size_t size;
+
+            char* data() { return reinterpret_cast<char*>(this+1); }
+        };
+
+        Chunk* new_chunk(std::size_t bytes);
+
+        std::size_t chunk_size_;
+        Chunk* head_ = nullptr;
+        Chunk* current_ = nullptr;
+        char* ptr_ = nullptr;
+        char* end_ = nullptr;
+    };
+
+    inline Arena::Arena(std::size_t chunk_size):
+        chunk_size_{chunk_size}
+    {}
+
+    inline Arena::~Arena() {
+        release();
+    }
+
+    inline void* Arena::allocate(std::size_t bytes, std::size_t align) {
+        auto aligned = [&](char* p) {
+            std::uintptr_t a = reinterpret_cast<std::uintptr_t>(p);
+            return reinterpret_cast<char*>((a+align-1) & ~(align-1));
+        };
+
+        char* p = ptr_ ? aligned(ptr_) : nullptr;
+
+        // aligning may step past the end of a full chunk
+        while (!p || p > end_ || bytes > std::size_t(end_-p)) {
+            // move on to the next chunk, reusing the ones kept by reset()
+            Chunk* c = current_ ? current_->next : head_;
+            if (!c || c->size < bytes+align) {
+                Chunk* fresh = new_chunk(bytes+align);
+                fresh->next = c;
+                if (current_) current_->next = fresh;
+                else head_ = fresh;
+                c = fresh;
+            }
+
+            current_ = c;
+            ptr_ = c->data();
+            end_ = ptr_+c->size;
+            p = aligned(ptr_);
+        }
+
+        ptr_ = p+bytes;
+        return p;
+    }
+
+    inline void Arena::deallocate(void* p, std::size_t bytes) {
+        // only the most recent block can be given back
+        if (static_cast<char*>(p)+bytes==ptr_)
+            ptr_ = static_cast<char*>(p);
+    }
+
+    inline bool Arena::try_expand(void* p, std::size_t old_bytes, std::size_t new_bytes) {
+        char* q = static_cast<char*>(p);
+
+        if (q+old_bytes!=ptr_ || new_bytes > std::size_t(end_-q)) return false;
+
+        ptr_ = q+new_bytes;
+        return true;
+    }
+
+    inline void Arena::reset() {
+        current_ = nullptr;
+        ptr_ = nullptr;
+        end_ = nullptr;
+    }
+
+    inline void Arena::release() {
+        while (head_) {
+            Chunk* next = head_->next;
+            std::free(head_);
+            head_ = next;
+        }
+        reset();
+    }
+
+    inline std::size_t Arena::chunk_count() const {
+        std::size_t n = 0;
+        for (Chunk* c = head_; c; c = c->next)
+            ++n;
+        return n;
+    }
+
+    inline Arena::Chunk* Arena::new_chunk(std::size_t bytes) {
+        std::size_t size = std::max(bytes, chunk_size_);
+
+        void* p = std::malloc(sizeof(Chunk)+size);
+        if (!p) throw std::bad_alloc{};
+
+        return new (p) Chunk{nullptr, size};
+    }
+
+    // allocator handing out memory from an Arena. deallocate is free, and
+    // the block at the top of the arena can grow in place.
+    template <typename T>
+    struct ArenaAllocator {
+        using value_type = T;
+        using size_type = std::size_t;
+        using propagate_on_container_move_assignment = std::true_type;
+        using propagate_on_container_swap = std::true_type;
+
+        ArenaAllocator(Arena& a): arena{&a} {}
+
+        template <typename U>
+        ArenaAllocator(const ArenaAllocator<U>& a): arena{a.arena} {}
+
+        T* allocate(size_type n) {
+            return static_cast<T*>(arena->allocate(n*sizeof(T), alignof(T)));
+        }
+
+        void deallocate(T* p, size_type n) {
+            arena->deallocate(p, n*sizeof(T));
+        }
+
+        bool try_expand(T* p, size_type old_n, size_type new_n) {
+            return arena->try_expand(p, old_n*sizeof(T), new_n*sizeof(T));
+        }
+
+        Arena* arena;
+    };
+
+    template <typename T, typename U>
+    bool operator==(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) { return a.arena==b.arena; }
+
+    template <typename T, typename U>
+    bool operator!=(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) { return a.arena!=b.arena; }
+
+    // Vector living in an Arena. For trivially destructible T destroying
+    // it does no work at all; the memory comes back with Arena::reset().
+    template <typename T, typename G = DoublingGrowth>
+    using ArenaVector = Vector<T, ArenaAllocator<T>, G>;
+}
+
+#endif
@@ -0,0 +1,73 @@
+#include "catch.hpp"
+#include "ArenaAllocator.hpp"
+#include <string>
+
+using namespace tutorial;
+
+TEST_CASE ("arenaVectorGrowsInPlace") {
+    Arena arena{1024};
+
+    ArenaVector<int> v{arena};
+    for (int i=0; i!=200; ++i)
+        v.push_back(i);
+
+    // the vector stays at the top of the arena and is extended in place
+    REQUIRE(v.size() == 200);
+    REQUIRE(arena.chunk_count() == 1);
+    REQUIRE(*(v.begin()+199) == 199);
+}
+
+TEST_CASE ("arenaAlignsPastFullChunk") {
+    // aligning the top of an exactly full, odd-sized chunk steps past its
+    // end, so the next allocation needs a new chunk
+    Arena arena{1001};
+    arena.allocate(1001, 1);
+
+    void* p = arena.allocate(4, 4);
+    REQUIRE(arena.chunk_count() == 2);
+    REQUIRE(reinterpret_cast<std::uintptr_t>(p) % 4 == 0);
+}
+
+TEST_CASE ("arenaResetReusesChunks") {
+    Arena arena{4096};
+
+    for (int round=0; round!=10; ++round) {
+        {
+            ArenaVector<double> a{arena};
+            ArenaVector<double> b{arena};
+            for (int i=0; i!=1000; ++i) {
+                a.push_back(i);
+                b.push_back(-i);
+            }
+
+            REQUIRE(*(a.begin()+999) == 999);
+            REQUIRE(*(b.begin()+999) == -999);
+        }
+        arena.reset();
+    }
+
+    // chunks allocated in the first round are reused after every reset
+    std::size_t chunks = arena.chunk_count();
+    {
+        ArenaVector<double> a{arena};
+        ArenaVector<double> b{arena};
+        for (int i=0; i!=1000; ++i) {
+            a.push_back(i);
+            b.push_back(-i);
+        }
+    }
+    REQUIRE(arena.chunk_count() == chunks);
+}
+
+TEST_CASE ("arenaVectorOfStrings") {
+    Arena arena;
+
+    ArenaVector<std::string> v{arena};
+    for (int i=0; i!=100; ++i)
+        v.push_back(std::to_string(i));
+
+    ArenaVector<std::string> w{v};
+    REQUIRE(w.size() == 100);
+    REQUIRE(w.get_allocator() == v.get_allocator());
+    REQUIRE(*(w.begin()+42) == "42");
+}
@@ -0,0 +1,338 @@
+#ifndef CONCURRENT_VECTOR_HPP
+#define CONCURRENT_VECTOR_HPP
+
+#include "SegmentedVector.hpp"
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+
+namespace tutorial {
+
+    template <typename T, std::size_t FirstBlock>
+    class ConcurrentVector;
+
+    // run of consecutive slots claimed by ConcurrentVector::reserve_slots.
+    // The slots start out as raw memory: every one of them must be
+    // constructed, from any threads, before the range is committed.
+    template <typename V>
+    class SlotRange {
+    public:
+        using size_type = typename V::size_type;
+        using value_type = typename V::value_type;
+
+        // index in the vector of the first slot
+        size_type first() const { return first_; }
+        size_type size() const { return n_; }
+
+        // constructs slot j of the range in place
+        template <typename... Args>
+        value_type& emplace(size_type j, Args&&... args) const {
+            value_type* p = &(*v_)[first_+j];
+            return *new(static_cast<void*>(p)) value_type(std::forward<Args>(args)...);
+        }
+
+        // calls f(p, count, j) for each contiguous run of count raw slots at
+        // p, j being the offset of p in the range. Useful to fill trivially
+        // copyable elements with memcpy.
+        template <typename F>
+        void for_each_segment(F f) const;
+
+    private:
+        friend V;
+
+        SlotRange(V* v, size_type first, size_type n): v_{v}, first_{first}, n_{n} {}
+
+        V* v_;
+        size_type first_;
+        size_type n_;
+    };
+
+    // append-only vector that any number of threads can push into at once.
+    // Elements live in blocks laid out like SegmentedVector's and never
+    // move. push_back claims a slot with one fetch_add and is lock-free;
+    // operator[] is wait-free for every index below size(), which only
+    // counts the prefix of elements whose construction has finished.
+    // Batches are appended with reserve_slots and commit, at the cost of
+    // one fetch_add for the whole batch. Destruction, copying and moving
+    // are not thread safe, and every reserved range must have been
+    // committed before the vector is destroyed.
+    template <typename T, std::size_t FirstBlock = 64>
+    class ConcurrentVector {
+        static_assert(FirstBlock && (FirstBlock & (FirstBlock-1))==0, "FirstBlock must be a power of two");
+
+    public:
+        using size_type = std::size_t;
+        using value_type = T;
+        using slot_range = SlotRange<ConcurrentVector>;
+
+        // largest range reserve_slots hands out
+        static constexpr size_type max_batch = UINT32_MAX;
+
+        ConcurrentVector() = default;
+        ~ConcurrentVector();
+
+        ConcurrentVector(const ConcurrentVector&) =delete;
+        ConcurrentVector& operator=(const ConcurrentVector&) =delete;
+
+        // number of elements that are fully constructed, all of them
+        // below the ones still being built
+        size_type size() const;
+        size_type capacity() const;
+
+        bool empty() const;
+
+        // allocates the blocks for n elements ahead of time
+        void reserve(size_type n);
+
+        // a throwing constructor would leave a slot that size() can never
+        // get past, so these terminate instead
+        void push_back(const T&) noexcept;
+        void push_back(T&&) noexcept;
+
+        template <typename... Args>
+        T& emplace_back(Args&&... args) noexcept;
+
+        // claims n consecutive slots for the caller to construct, possibly
+        // from several threads. Throws std::length_error past max_batch.
+        slot_range reserve_slots(size_type n);
+
+        // makes the elements of r visible, once everything before them is
+        void commit(const slot_range& r);
+
+        T& operator[](size_type i);
+        const T& operator[](size_type i) const;
+
+    private:
+        friend slot_range;
+
+        static constexpr std::size_t shift = log2_floor(FirstBlock);
+        static constexpr std::size_t max_blocks = 64-shift;
+
+        static constexpr size_type block_size(std::size_t k) { return size_type(FirstBlock) << k; }
+        static constexpr size_type block_start(std::size_t k) { return (block_size(k)-FirstBlock); }
+
+        static std::size_t block_of(size_type i);
+
+        // done[i] is the length of the finished run of slots starting at
+        // i, or 0. The array follows the elements in the same allocation.
+        using Done = std::atomic<std::uint32_t>;
+
+        static constexpr std::size_t block_align = std::max(alignof(T), alignof(Done));
+        static std::size_t done_offset(std::size_t k);
+        static Done* done(T* block, std::size_t k);
+
+        // zero-filled memory for block k and its done array
+        static T* allocate_block(std::size_t k);
+        static void deallocate_block(T* block);
+
+        // returns block k, allocating it if no other thread has yet
+        T* get_block(std::size_t k);
+
+        // marks slots [i, i+n) finished and moves size() past every
+        // finished slot
+        void publish(size_type i, size_type n);
+
+        std::atomic<T*> blocks_[max_blocks] = {};
+        std::atomic<size_type> claimed_{0};
+        std::atomic<size_type> size_{0};
+    };
+
+    template <typename T, std::size_t FirstBlock>
+    ConcurrentVector<T,FirstBlock>::~ConcurrentVector() {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            for (size_type i=0, n=size(); i!=n; ++i)
+                (*this)[i].~T();
+        }
+
+        for (auto& b : blocks_) {
+            if (T* block = b.load())
+                deallocate_block(block);
+        }
+    }
+
+    template <typename T, std::size_t FirstBlock>
+    typename ConcurrentVector<T,FirstBlock>::size_type ConcurrentVector<T,FirstBlock>::size() const {
+        return size_.load(std::memory_order_acquire);
+    }
+
+    template <typename T, std::size_t FirstBlock>
+    typename ConcurrentVector<T,FirstBlock>::size_type ConcurrentVector<T,FirstBlock>::capacity() const {
+        size_type cap = 0;
+        for (std::size_t k=0; k!=max_blocks && blocks_[k].load(std::memory_order_acquire); ++k)
+            cap = block_start(k+1);
+        return cap;
+    }
+
+    template <typename T, std::size_t FirstBlock>
+    bool ConcurrentVector<T,FirstBlock>::empty() const {
+        return size()==0;
+    }
+
+    template <typename T, std::size_t FirstBlock>
+    void ConcurrentVector<T,FirstBlock>::reserve(size_type n) {
+        for (std::size_t k=0; k!=max_blocks && block_start(k) < n; ++k)
+            get_block(k);
+    }
+
+    template <typename T, std::size_t FirstBlock>
+    void ConcurrentVector<T,FirstBlock>::push_back(const T& val) noexcept {
+        emplace_back(val);
+    }
+
+    template <typename T, std::size_t FirstBlock>
+    void ConcurrentVector<T,FirstBlock>::push_back(T&& val) noexcept {
+        emplace_back(std::move(val));
+    }
+
+    template <typename T, std::size_t FirstBlock>
+    template <typename... Args>
+    T& ConcurrentVector<T,FirstBlock>::emplace_back(Args&&... args) noexcept {
+        size_type i = claimed_.fetch_add(1, std::memory_order_relaxed);
+
+        std::size_t k = block_of(i);
+        T* p = get_block(k)+(i-block_start(k));
+        new(static_cast<void*>(p)) T(std::forward<Args>(args)...);
+
+        publish(i, 1);
+        return *p;
+    }
+
+    template <typename T, std::size_t FirstBlock>
+    typename ConcurrentVector<T,FirstBlock>::slot_range ConcurrentVector<T,FirstBlock>::reserve_slots(size_type n) {
+        if (n > max_batch) throw std::length_error{"ConcurrentVector batch is too large"};
+
+        size_type i = claimed_.fetch_add(n, std::memory_order_relaxed);
+        if (n) {
+            // if this throws the slots are lost, and so is everything
+            // appended after them
+            for (std::size_t k = block_of(i); k <= block_of(i+n-1); ++k)
+                get_block(k);
+        }
+
+        return slot_range{this, i, n};
+    }
+
+    template <typename T, std::size_t FirstBlock>
+    void ConcurrentVector<T,FirstBlock>::commit(const slot_range& r) {
+        if (r.size()) publish(r.first(), r.size());
+    }
+
+    template <typename T, std::size_t FirstBlock>
+    T& ConcurrentVector<T,FirstBlock>::operator[](size_type i) {
+        std::size_t k = block_of(i);
+        return blocks_[k].load(std::memory_order_acquire)[i-block_start(k)];
+    }
+
+    template <typename T, std::size_t FirstBlock>
+    const T& ConcurrentVector<T,FirstBlock>::operator[](size_type i) const {
+        std::size_t k = block_of(i);
+        return blocks_[k].load(std::memory_order_acquire)[i-block_start(k)];
+    }
+
+    template <typename T, std::size_t FirstBlock>
+    std::size_t ConcurrentVector<T,FirstBlock>::block_of(size_type i) {
+        return log2_floor((i >> shift)+1);
+    }
+
+    template <typename T, std::size_t FirstBlock>
+    std::size_t ConcurrentVector<T,FirstBlock>::done_offset(std::size_t k) {
+        return (block_size(k)*sizeof(T)+alignof(Done)-1) / alignof(Done) * alignof(Done);
+    }
+
+    template <typename T, std::size_t FirstBlock>
+    typename ConcurrentVector<T,FirstBlock>::Done* ConcurrentVector<T,FirstBlock>::done(T* block, std::size_t k) {
+        return reinterpret_cast<Done*>(reinterpret_cast<char*>(block)+done_offset(k));
+    }
+
+    template <typename T, std::size_t FirstBlock>
+    T* ConcurrentVector<T,FirstBlock>::allocate_block(std::size_t k) {
+        std::size_t bytes = done_offset(k)+block_size(k)*sizeof(Done);
+
+        // the done entries start out as 0 without being written: large
+        // calloc blocks come straight from fresh mappings
+        if constexpr (block_align <= alignof(std::max_align_t)) {
+            void* p = std::calloc(1, bytes);
+            if (!p) throw std::bad_alloc{};
+            return static_cast<T*>(p);
+        }
+        else {
+            void* p = ::operator new(bytes, std::align_val_t{block_align});
+            std::memset(static_cast<char*>(p)+done_offset(k), 0, block_size(k)*sizeof(Done));
+            return static_cast<T*>(p);
+        }
+    }
+
+    template <typename T, std::size_t FirstBlock>
+    void ConcurrentVector<T,FirstBlock>::deallocate_block(T* block) {
+        if constexpr (block_align <= alignof(std::max_align_t))
+            std::free(block);
+        else
+            ::operator delete(block, std::align_val_t{block_align});
+    }
+
+    template <typename T, std::size_t FirstBlock>
+    T* ConcurrentVector<T,FirstBlock>::get_block(std::size_t k) {
+        T* block = blocks_[k].load(std::memory_order_acquire);
+        if (block) return block;
+
+        // the block comes zeroed rather than written, so threads racing
+        // here lose little by each allocating one
+        T* fresh = allocate_block(k);
+
+        // another thread may have installed the block in the meantime
+        if (blocks_[k].compare_exchange_strong(block, fresh, std::memory_order_acq_rel))
+            return fresh;
+
+        deallocate_block(fresh);
+        return block;
+    }
+
+    template <typename T, std::size_t FirstBlock>
+    void ConcurrentVector<T,FirstBlock>::publish(size_type i, size_type n) {
+        // whoever finishes the run at size() moves it forward, over the
+        // runs that finished before it. The done stores and the size_
+        // updates are sequentially consistent, so a run finishing just as
+        // size_ reaches it is always seen by one of the two threads.
+        size_type s = i;
+        if (size_.compare_exchange_strong(s, i+n)) {
+            // no one else will look at this run's done entry
+            s = i+n;
+        }
+        else {
+            std::size_t k = block_of(i);
+            done(blocks_[k].load(std::memory_order_acquire), k)[i-block_start(k)].store(std::uint32_t(n));
+            s = size_.load();
+        }
+
+        for (;;) {
+            std::size_t b = block_of(s);
+            T* block = blocks_[b].load(std::memory_order_acquire);
+            if (!block) return;
+
+            size_type len = done(block, b)[s-block_start(b)].load();
+            if (!len) return;
+
+            // on failure s is reloaded and the check runs again
+            if (size_.compare_exchange_weak(s, s+len))
+                s += len;
+        }
+    }
+
+    template <typename V>
+    template <typename F>
+    void SlotRange<V>::for_each_segment(F f) const {
+        for (size_type j=0; j!=n_; ) {
+            size_type i = first_+j;
+            size_type k = V::block_of(i);
+            size_type count = std::min(n_-j, V::block_start(k+1)-i);
+
+            f(&(*v_)[i], count, j);
+            j += count;
+        }
+    }
+}
+
+#endif
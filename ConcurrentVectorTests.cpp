@@ -0,0 +1,165 @@
+#include "catch.hpp"
+#include "ConcurrentVector.hpp"
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace tutorial;
+
+TEST_CASE ("concurrentVectorSingleThread") {
+    ConcurrentVector<std::string, 4> v;
+    REQUIRE(v.empty());
+
+    for (int i=0; i!=100; ++i)
+        v.push_back(std::to_string(i));
+
+    REQUIRE(v.size() == 100);
+    REQUIRE(v.capacity() == 124);
+    REQUIRE(v[0] == "0");
+    REQUIRE(v[99] == "99");
+
+    std::string& s = v.emplace_back(3, 'x');
+    REQUIRE(&s == &v[100]);
+    REQUIRE(s == "xxx");
+
+    ConcurrentVector<int> r;
+    r.reserve(1000);
+    REQUIRE(r.capacity() >= 1000);
+    REQUIRE(r.empty());
+
+    // over-aligned elements can't come from calloc
+    struct alignas(64) Line { int x; };
+    ConcurrentVector<Line, 4> lines;
+    for (int i=0; i!=100; ++i)
+        lines.push_back(Line{i});
+    REQUIRE(lines.size() == 100);
+    REQUIRE(lines[99].x == 99);
+    REQUIRE(reinterpret_cast<std::uintptr_t>(&lines[50]) % 64 == 0);
+}
+
+namespace {
+    struct Event {
+        Event(std::uint64_t id): id{id}, check{~id} {}
+
+        std::uint64_t id;
+        std::uint64_t check;
+    };
+}
+
+TEST_CASE ("concurrentVectorManyWriters") {
+    constexpr int threads = 8;
+    constexpr int per_thread = 20000;
+
+    ConcurrentVector<Event, 16> v;
+    std::atomic<bool> done{false};
+    std::atomic<int> torn{0};
+
+    // a reader checking that everything below size() is fully written
+    std::thread reader([&] {
+        while (!done) {
+            std::size_t n = v.size();
+            for (std::size_t i = n>100 ? n-100 : 0; i!=n; ++i) {
+                if (v[i].check != ~v[i].id) ++torn;
+            }
+        }
+    });
+
+    std::vector<std::thread> writers;
+    for (int t=0; t!=threads; ++t) {
+        writers.emplace_back([&v, t] {
+            for (int i=0; i!=per_thread; ++i)
+                v.emplace_back(std::uint64_t(t)*per_thread+i);
+        });
+    }
+    for (auto& w : writers)
+        w.join();
+    done = true;
+    reader.join();
+
+    REQUIRE(torn == 0);
+    REQUIRE(v.size() == threads*per_thread);
+
+    // every event appears exactly once
+    std::vector<bool> seen(threads*per_thread);
+    bool unique = true;
+    for (std::size_t i=0; i!=v.size(); ++i) {
+        unique = unique && !seen[v[i].id];
+        seen[v[i].id] = true;
+    }
+    REQUIRE(unique);
+}
+
+TEST_CASE ("concurrentVectorReserveSlots") {
+    ConcurrentVector<std::string, 4> v;
+    v.push_back("first");
+
+    auto a = v.reserve_slots(10);
+    auto b = v.reserve_slots(3);
+    REQUIRE(a.first() == 1);
+    REQUIRE(b.first() == 11);
+
+    for (std::size_t j=0; j!=b.size(); ++j)
+        b.emplace(j, "b");
+    v.commit(b);
+
+    // b is done but waits behind a
+    REQUIRE(v.size() == 1);
+
+    for (std::size_t j=0; j!=a.size(); ++j)
+        a.emplace(j, std::to_string(j));
+    v.commit(a);
+
+    REQUIRE(v.size() == 14);
+    REQUIRE(v[10] == "9");
+    REQUIRE(v[13] == "b");
+
+    // a range spanning several blocks, filled a segment at a time
+    ConcurrentVector<int, 4> w;
+    auto r = w.reserve_slots(100);
+    std::size_t segments = 0;
+    r.for_each_segment([&](int* p, std::size_t count, std::size_t j) {
+        for (std::size_t x=0; x!=count; ++x)
+            p[x] = int(j+x);
+        ++segments;
+    });
+    w.commit(r);
+
+    REQUIRE(segments == 5);
+    REQUIRE(w.size() == 100);
+    for (int i=0; i!=100; ++i)
+        REQUIRE(w[i] == i);
+
+    REQUIRE(w.reserve_slots(0).size() == 0);
+}
+
+TEST_CASE ("concurrentVectorBatchWriters") {
+    constexpr int threads = 8;
+    constexpr int batches = 50;
+    constexpr int batch = 300;
+
+    ConcurrentVector<Event, 16> v;
+
+    std::vector<std::thread> writers;
+    for (int t=0; t!=threads; ++t) {
+        writers.emplace_back([&v, t] {
+            for (int b=0; b!=batches; ++b) {
+                auto r = v.reserve_slots(batch);
+                for (int j=0; j!=batch; ++j)
+                    r.emplace(j, (std::uint64_t(t)*batches+b)*batch+j);
+                v.commit(r);
+            }
+        });
+    }
+    for (auto& w : writers)
+        w.join();
+
+    REQUIRE(v.size() == threads*batches*batch);
+
+    // each batch is contiguous
+    bool contiguous = true;
+    for (std::size_t i=0; i!=v.size(); i+=batch) {
+        for (int j=0; j!=batch; ++j)
+            contiguous = contiguous && v[i+j].id==v[i].id+j;
+    }
+    REQUIRE(contiguous);
+}
@@ -0,0 +1,74 @@
+#ifndef CRC32C_HPP
+#define CRC32C_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#endif
+
+namespace tutorial {
+
+    // CRC-32C (Castagnoli), continuing from a previous crc value. Uses the
+    // SSE4.2 crc32 instruction when the CPU has it, a table otherwise.
+    inline std::uint32_t crc32c(const void* data, std::size_t n, std::uint32_t crc = 0);
+
+    inline std::uint32_t crc32c_table(const unsigned char* p, std::size_t n, std::uint32_t crc) {
+        struct Table {
+            Table() {
+                for (std::uint32_t i = 0; i!=256; ++i) {
+                    std::uint32_t c = i;
+                    for (int k = 0; k!=8; ++k)
+                        c = c&1 ? (c >> 1) ^ 0x82F63B78u : c >> 1;
+                    t[i] = c;
+                }
+            }
+
+            std::uint32_t t[256];
+        };
+        static const Table table;
+
+        for (; n; --n, ++p)
+            crc = table.t[(crc ^ *p) & 0xff] ^ (crc >> 8);
+        return crc;
+    }
+
+#if defined(__GNUC__) && defined(__x86_64__)
+
+    __attribute__((target("sse4.2")))
+    inline std::uint32_t crc32c_sse42(const unsigned char* p, std::size_t n, std::uint32_t crc) {
+        std::uint64_t c = crc;
+        for (; n>=8; n-=8, p+=8) {
+            std::uint64_t v;
+            std::memcpy(&v, p, 8);
+            c = _mm_crc32_u64(c, v);
+        }
+
+        std::uint32_t c32 = static_cast<std::uint32_t>(c);
+        for (; n; --n, ++p)
+            c32 = _mm_crc32_u8(c32, *p);
+        return c32;
+    }
+
+    inline std::uint32_t crc32c(const void* data, std::size_t n, std::uint32_t crc) {
+        static const bool sse42 = __builtin_cpu_supports("sse4.2");
+        const unsigned char* p = static_cast<const unsigned char*>(data);
+
+        crc = ~crc;
+        crc = sse42 ? crc32c_sse42(p, n, crc) : crc32c_table(p, n, crc);
+        return ~crc;
+    }
+
+#else
+
+    inline std::uint32_t crc32c(const void* data, std::size_t n, std::uint32_t crc) {
+        return ~crc32c_table(static_cast<const unsigned char*>(data), n, ~crc);
+    }
+
+#endif
+
+}
+
+#endif
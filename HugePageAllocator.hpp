@@ -0,0 +1,104 @@
+#ifndef HUGE_PAGE_ALLOCATOR_HPP
+#define HUGE_PAGE_ALLOCATOR_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <sys/mman.h>
+
+namespace tutorial {
+
+    // allocator for large vectors that backs them with huge pages to cut
+    // TLB misses. Blocks of at least Threshold bytes are mapped with
+    // MAP_HUGETLB when the system has huge pages reserved, and otherwise
+    // with a 2 MB aligned anonymous mapping marked MADV_HUGEPAGE for
+    // transparent huge pages. Smaller blocks come from malloc.
+    template <typename T, std::size_t Threshold = std::size_t(2) << 20>
+    struct HugePageAllocator {
+        static constexpr std::size_t huge_page = std::size_t(2) << 20;
+
+        using value_type = T;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+
+        template <typename U>
+        struct rebind { using other = HugePageAllocator<U, Threshold>; };
+
+        HugePageAllocator() = default;
+
+        template <typename U>
+        HugePageAllocator(const HugePageAllocator<U, Threshold>&) {}
+
+        T* allocate(size_type n) {
+            size_type bytes = n*sizeof(T);
+
+            if (bytes < Threshold) {
+                void* p = std::malloc(bytes);
+                if (!p) throw std::bad_alloc{};
+                return static_cast<T*>(p);
+            }
+
+            return static_cast<T*>(map(mapped_bytes(bytes)));
+        }
+
+        // fresh anonymous mappings are already zero filled
+        T* allocate_zeroed(size_type n) {
+            size_type bytes = n*sizeof(T);
+
+            if (bytes < Threshold) {
+                void* p = std::calloc(n, sizeof(T));
+                if (!p) throw std::bad_alloc{};
+                return static_cast<T*>(p);
+            }
+
+            return static_cast<T*>(map(mapped_bytes(bytes)));
+        }
+
+        void deallocate(T* p, size_type n) {
+            size_type bytes = n*sizeof(T);
+
+            if (bytes < Threshold) std::free(p);
+            else munmap(p, mapped_bytes(bytes));
+        }
+
+        static size_type mapped_bytes(size_type bytes) {
+            return (bytes+huge_page-1) / huge_page * huge_page;
+        }
+
+        static void* map(size_type len) {
+#ifdef MAP_HUGETLB
+            // explicit huge pages, only available if the admin reserved them
+            void* h = mmap(nullptr, len, PROT_READ|PROT_WRITE,
+                           MAP_PRIVATE|MAP_ANONYMOUS|MAP_HUGETLB, -1, 0);
+            if (h!=MAP_FAILED) return h;
+#endif
+
+            // over-allocate so the block can start on a huge page boundary
+            void* raw = mmap(nullptr, len+huge_page, PROT_READ|PROT_WRITE,
+                             MAP_PRIVATE|MAP_ANONYMOUS, -1, 0);
+            if (raw==MAP_FAILED) throw std::bad_alloc{};
+
+            char* base = static_cast<char*>(raw);
+            std::uintptr_t a = reinterpret_cast<std::uintptr_t>(base);
+            char* p = reinterpret_cast<char*>((a+huge_page-1) & ~(huge_page-1));
+
+            // give back the unaligned head and the unused tail
+            if (p!=base) munmap(base, p-base);
+            if (base+len+huge_page!=p+len) munmap(p+len, base+len+huge_page-(p+len));
+
+#ifdef MADV_HUGEPAGE
+            madvise(p, len, MADV_HUGEPAGE);
+#endif
+            return p;
+        }
+    };
+
+    template <typename T, typename U, std::size_t Threshold>
+    bool operator==(const HugePageAllocator<T, Threshold>&, const HugePageAllocator<U, Threshold>&) { return true; }
+
+    template <typename T, typename U, std::size_t Threshold>
+    bool operator!=(const HugePageAllocator<T, Threshold>&, const HugePageAllocator<U, Threshold>&) { return false; }
+}
+
+#endif
@@ -0,0 +1,29 @@
+#include "catch.hpp"
+#include "Vector.hpp"
+#include "HugePageAllocator.hpp"
+
+using namespace tutorial;
+
+TEST_CASE ("hugePageAllocatorSmallBlocks") {
+    // below the threshold, plain malloc
+    Vector<int, HugePageAllocator<int>> v;
+    for (int i=0; i!=1000; ++i)
+        v.push_back(i);
+
+    REQUIRE(v.size() == 1000);
+    REQUIRE(*(v.begin()+999) == 999);
+}
+
+TEST_CASE ("hugePageAllocatorLargeBlocks") {
+    Vector<long, HugePageAllocator<long>> v(1 << 20, 7L);
+
+    // large blocks start on a huge page boundary
+    auto addr = reinterpret_cast<std::uintptr_t>(v.begin());
+    REQUIRE(addr % HugePageAllocator<long>::huge_page == 0);
+    REQUIRE(*(v.end()-1) == 7);
+
+    for (int i=0; i!=1000; ++i)
+        v.push_back(i);
+    REQUIRE(v.size() == (1 << 20)+1000);
+    REQUIRE(*(v.end()-1) == 999);
+}
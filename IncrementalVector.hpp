@@ -0,0 +1,379 @@
+#ifndef INCREMENTAL_VECTOR_HPP
+#define INCREMENTAL_VECTOR_HPP
+
+#include "Vector.hpp"
+#include "SegmentedVector.hpp"
+
+namespace tutorial {
+
+    // vector that spreads the cost of growing over later operations, like
+    // incremental rehashing. Growing only allocates the new buffer; each
+    // push_back, emplace_back and pop_back then relocates up to K elements
+    // from the old buffer, and operator[] reads from whichever buffer holds
+    // the index. A push_back costs O(K) in the worst case. With the default
+    // doubling growth the old buffer is drained before the next growth;
+    // otherwise growing finishes the pending migration first. The elements
+    // are only contiguous once settled().
+    template <typename T, typename A = std::allocator<T>, std::size_t K = 8, typename G = DoublingGrowth>
+    class IncrementalVector {
+        static_assert(K > 0, "IncrementalVector must migrate at least one element per operation");
+
+    public:
+        using size_type = typename std::allocator_traits<A>::size_type;
+        using allocator_type = A;
+        using iterator = SegmentedIterator<IncrementalVector, T>;
+        using const_iterator = SegmentedIterator<const IncrementalVector, const T>;
+        using value_type = T;
+        using growth_policy = G;
+
+        explicit IncrementalVector(const A& = A());
+        IncrementalVector(std::initializer_list<value_type> data, const A& = A());
+        ~IncrementalVector();
+
+        // copy operations
+        IncrementalVector(const IncrementalVector& rhs);
+        IncrementalVector& operator=(const IncrementalVector& rhs);
+
+        // move operations
+        IncrementalVector(IncrementalVector&& a);
+        IncrementalVector& operator=(IncrementalVector&& a);
+
+        void swap(IncrementalVector& a);
+        allocator_type get_allocator() const;
+
+        size_type size() const;
+        size_type capacity() const;
+
+        bool empty() const;
+        void destroy();
+
+        void reserve(size_type n);
+        void clear();
+        void push_back(const T&);
+        void push_back(T&&);
+        void pop_back();
+
+        template <typename... Args>
+        T& emplace_back(Args&&... args);
+
+        // whether every element is in the current buffer
+        bool settled() const;
+
+        // finishes a pending migration in one go
+        void settle();
+
+        T& operator[](size_type i);
+        const T& operator[](size_type i) const;
+
+        iterator begin();
+        const_iterator begin() const;
+
+        iterator end();
+        const_iterator end() const;
+
+    private:
+        using traits = std::allocator_traits<A>;
+
+        // relocates up to n elements from the old buffer
+        void migrate(size_type n);
+
+        void deallocate();
+
+        A alloc_;
+        T* elem_ = nullptr;
+        size_type sz_ = 0;
+        size_type cap_ = 0;
+
+        // elements [moved_, old_sz_) still live in old_
+        T* old_ = nullptr;
+        size_type old_cap_ = 0;
+        size_type moved_ = 0;
+        size_type old_sz_ = 0;
+    };
+
+    template <typename T, typename A, std::size_t K, typename G>
+    IncrementalVector<T,A,K,G>::IncrementalVector(const A& a):
+        alloc_{a}
+    {}
+
+    template <typename T, typename A, std::size_t K, typename G>
+    IncrementalVector<T,A,K,G>::IncrementalVector(std::initializer_list<value_type> data, const A& a):
+        alloc_{a}
+    {
+        reserve(data.size());
+        for (const T& x : data)
+            emplace_back(x);
+    }
+
+    template <typename T, typename A, std::size_t K, typename G>
+    IncrementalVector<T,A,K,G>::~IncrementalVector() {
+        destroy();
+        deallocate();
+    }
+
+    template <typename T, typename A, std::size_t K, typename G>
+    IncrementalVector<T,A,K,G>::IncrementalVector(const IncrementalVector& rhs):
+        alloc_{traits::select_on_container_copy_construction(rhs.alloc_)}
+    {
+        reserve(rhs.size());
+        for (const T& x : rhs)
+            emplace_back(x);
+    }
+
+    template <typename T, typename A, std::size_t K, typename G>
+    IncrementalVector<T,A,K,G>& IncrementalVector<T,A,K,G>::operator=(const IncrementalVector& rhs) {
+        if (&rhs == this) return *this;
+
+        destroy();
+
+        if constexpr (traits::propagate_on_container_copy_assignment::value) {
+            if (alloc_!=rhs.alloc_) {
+                // the buffer belongs to the old allocator, release it first
+                deallocate();
+                alloc_ = rhs.alloc_;
+            }
+        }
+
+        reserve(rhs.size());
+        for (const T& x : rhs)
+            emplace_back(x);
+
+        return *this;
+    }
+
+    template <typename T, typename A, std::size_t K, typename G>
+    IncrementalVector<T,A,K,G>::IncrementalVector(IncrementalVector&& a):
+        alloc_{a.alloc_},
+        elem_{a.elem_},
+        sz_{a.sz_},
+        cap_{a.cap_},
+        old_{a.old_},
+        old_cap_{a.old_cap_},
+        moved_{a.moved_},
+        old_sz_{a.old_sz_}
+    {
+        a.elem_ = a.old_ = nullptr;
+        a.sz_ = a.cap_ = a.old_cap_ = a.moved_ = a.old_sz_ = 0;
+    }
+
+    template <typename T, typename A, std::size_t K, typename G>
+    IncrementalVector<T,A,K,G>& IncrementalVector<T,A,K,G>::operator=(IncrementalVector&& a) {
+        if (&a == this) return *this;
+
+        if constexpr (traits::propagate_on_container_move_assignment::value) {
+            std::swap(alloc_, a.alloc_);
+        }
+        else if constexpr (!traits::is_always_equal::value) {
+            if (alloc_!=a.alloc_) {
+                // a's buffers can't be adopted, move the elements instead
+                destroy();
+                reserve(a.size());
+                for (T& x : a)
+                    emplace_back(std::move(x));
+                a.destroy();
+
+                return *this;
+            }
+        }
+
+        // swap representations
+        std::swap(elem_, a.elem_);
+        std::swap(sz_, a.sz_);
+        std::swap(cap_, a.cap_);
+        std::swap(old_, a.old_);
+        std::swap(old_cap_, a.old_cap_);
+        std::swap(moved_, a.moved_);
+        std::swap(old_sz_, a.old_sz_);
+
+        return *this;
+    }
+
+    template <typename T, typename A, std::size_t K, typename G>
+    void IncrementalVector<T,A,K,G>::swap(IncrementalVector& a) {
+        // allocators are only exchanged if they propagate on swap,
+        // otherwise they must compare equal
+        if constexpr (traits::propagate_on_container_swap::value)
+            std::swap(alloc_, a.alloc_);
+        std::swap(elem_, a.elem_);
+        std::swap(sz_, a.sz_);
+        std::swap(cap_, a.cap_);
+        std::swap(old_, a.old_);
+        std::swap(old_cap_, a.old_cap_);
+        std::swap(moved_, a.moved_);
+        std::swap(old_sz_, a.old_sz_);
+    }
+
+    template <typename T, typename A, std::size_t K, typename G>
+    typename IncrementalVector<T,A,K,G>::allocator_type IncrementalVector<T,A,K,G>::get_allocator() const {
+        return alloc_;
+    }
+
+    template <typename T, typename A, std::size_t K, typename G>
+    typename IncrementalVector<T,A,K,G>::size_type IncrementalVector<T,A,K,G>::size() const {
+        return sz_;
+    }
+
+    template <typename T, typename A, std::size_t K, typename G>
+    typename IncrementalVector<T,A,K,G>::size_type IncrementalVector<T,A,K,G>::capacity() const {
+        return cap_;
+    }
+
+    template <typename T, typename A, std::size_t K, typename G>
+    bool IncrementalVector<T,A,K,G>::empty() const {
+        return sz_==0;
+    }
+
+    template <typename T, typename A, std::size_t K, typename G>
+    void IncrementalVector<T,A,K,G>::destroy() {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            for (size_type i=0; i!=sz_; ++i)
+                (*this)[i].~T();
+        }
+        sz_ = 0;
+
+        if (old_) traits::deallocate(alloc_, old_, old_cap_);
+        old_ = nullptr;
+        old_cap_ = moved_ = old_sz_ = 0;
+    }
+
+    template <typename T, typename A, std::size_t K, typename G>
+    void IncrementalVector<T,A,K,G>::reserve(size_type n) {
+        if (n <= cap_) return;
+
+        // only one old buffer at a time
+        settle();
+
+        T* elem = traits::allocate(alloc_, n);
+
+        // the elements move over later, starting from the front
+        old_ = elem_;
+        old_cap_ = cap_;
+        moved_ = 0;
+        old_sz_ = sz_;
+
+        elem_ = elem;
+        cap_ = n;
+
+        if (sz_==0) settle();
+    }
+
+    template <typename T, typename A, std::size_t K, typename G>
+    void IncrementalVector<T,A,K,G>::clear() {
+        destroy();
+    }
+
+    template <typename T, typename A, std::size_t K, typename G>
+    void IncrementalVector<T,A,K,G>::push_back(const T& val) {
+        emplace_back(val);
+    }
+
+    template <typename T, typename A, std::size_t K, typename G>
+    void IncrementalVector<T,A,K,G>::push_back(T&& val) {
+        emplace_back(std::move(val));
+    }
+
+    template <typename T, typename A, std::size_t K, typename G>
+    void IncrementalVector<T,A,K,G>::pop_back() {
+        --sz_;
+        (*this)[sz_].~T();
+
+        // the last element may not have been migrated yet
+        if (sz_ < old_sz_) old_sz_ = sz_;
+
+        migrate(K);
+    }
+
+    template <typename T, typename A, std::size_t K, typename G>
+    template <typename... Args>
+    T& IncrementalVector<T,A,K,G>::emplace_back(Args&&... args) {
+        T* p;
+
+        if (sz_==cap_ && !settled()) {
+            // growing finishes the pending migration and frees the old
+            // buffer, so build the element aside first: args may refer to
+            // an element that is still there
+            T val(std::forward<Args>(args)...);
+            reserve(G::next_capacity(cap_, sz_+1));
+            p = elem_+sz_;
+            traits::construct(alloc_, p, std::move(val));
+        }
+        else {
+            // growing a settled vector keeps the old buffer alive, so args
+            // may still refer to an element while the new one is constructed
+            if (sz_==cap_) reserve(G::next_capacity(cap_, sz_+1));
+            p = elem_+sz_;
+            traits::construct(alloc_, p, std::forward<Args>(args)...);
+        }
+        ++sz_;
+
+        migrate(K);
+        return *p;
+    }
+
+    template <typename T, typename A, std::size_t K, typename G>
+    bool IncrementalVector<T,A,K,G>::settled() const {
+        return old_==nullptr;
+    }
+
+    template <typename T, typename A, std::size_t K, typename G>
+    void IncrementalVector<T,A,K,G>::settle() {
+        if (old_) migrate(old_sz_-moved_);
+    }
+
+    template <typename T, typename A, std::size_t K, typename G>
+    T& IncrementalVector<T,A,K,G>::operator[](size_type i) {
+        // one unsigned compare for moved_ <= i < old_sz_
+        if (i-moved_ < old_sz_-moved_) return old_[i];
+        return elem_[i];
+    }
+
+    template <typename T, typename A, std::size_t K, typename G>
+    const T& IncrementalVector<T,A,K,G>::operator[](size_type i) const {
+        if (i-moved_ < old_sz_-moved_) return old_[i];
+        return elem_[i];
+    }
+
+    template <typename T, typename A, std::size_t K, typename G>
+    typename IncrementalVector<T,A,K,G>::iterator IncrementalVector<T,A,K,G>::begin() {
+        return iterator{this, 0};
+    }
+
+    template <typename T, typename A, std::size_t K, typename G>
+    typename IncrementalVector<T,A,K,G>::const_iterator IncrementalVector<T,A,K,G>::begin() const {
+        return const_iterator{this, 0};
+    }
+
+    template <typename T, typename A, std::size_t K, typename G>
+    typename IncrementalVector<T,A,K,G>::iterator IncrementalVector<T,A,K,G>::end() {
+        return iterator{this, sz_};
+    }
+
+    template <typename T, typename A, std::size_t K, typename G>
+    typename IncrementalVector<T,A,K,G>::const_iterator IncrementalVector<T,A,K,G>::end() const {
+        return const_iterator{this, sz_};
+    }
+
+    template <typename T, typename A, std::size_t K, typename G>
+    void IncrementalVector<T,A,K,G>::migrate(size_type n) {
+        if (!old_) return;
+
+        n = std::min(n, old_sz_-moved_);
+        uninitialized_relocate(old_+moved_, old_+moved_+n, elem_+moved_);
+        moved_ += n;
+
+        if (moved_==old_sz_) {
+            traits::deallocate(alloc_, old_, old_cap_);
+            old_ = nullptr;
+            old_cap_ = moved_ = old_sz_ = 0;
+        }
+    }
+
+    template <typename T, typename A, std::size_t K, typename G>
+    void IncrementalVector<T,A,K,G>::deallocate() {
+        if (elem_) traits::deallocate(alloc_, elem_, cap_);
+        elem_ = nullptr;
+        cap_ = 0;
+    }
+}
+
+#endif
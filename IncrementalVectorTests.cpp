@@ -0,0 +1,112 @@
+#include "catch.hpp"
+#include "IncrementalVector.hpp"
+#include <memory_resource>
+#include <string>
+
+using namespace tutorial;
+
+TEST_CASE ("incrementalVectorMigratesGradually") {
+    IncrementalVector<int, std::allocator<int>, 2> v;
+    for (int i=0; i!=16; ++i)
+        v.push_back(i);
+    REQUIRE(v.settled());
+    REQUIRE(v.capacity() == 16);
+
+    // growing leaves the 16 elements in the old buffer, two move per push
+    v.push_back(16);
+    REQUIRE(v.capacity() == 32);
+    REQUIRE_FALSE(v.settled());
+    for (int i=0; i!=17; ++i)
+        REQUIRE(v[i] == i);
+
+    for (int i=17; i!=24; ++i)
+        v.push_back(i);
+    REQUIRE(v.settled());
+    for (int i=0; i!=24; ++i)
+        REQUIRE(v[i] == i);
+}
+
+TEST_CASE ("incrementalVectorOperations") {
+    IncrementalVector<std::string> v{"a", "b", "c"};
+    for (int i=0; i!=100; ++i)
+        v.push_back(std::to_string(i));
+
+    // growing from one of its own elements
+    v.emplace_back(v[0]);
+    REQUIRE(v[103] == "a");
+
+    // growing while a migration is pending, from an element that has not
+    // been migrated yet
+    IncrementalVector<std::string> u;
+    for (int i=0; i!=16; ++i)
+        u.push_back(std::string(32, 'a'+i));
+    u.reserve(17);
+    u.push_back(u[0]);
+    REQUIRE_FALSE(u.settled());
+    REQUIRE(u.size() == u.capacity());
+    u.push_back(u[15]);
+    REQUIRE(u[17] == std::string(32, 'p'));
+    REQUIRE(u[16] == std::string(32, 'a'));
+
+    // popping elements that are still in the old buffer
+    IncrementalVector<std::string, std::allocator<std::string>, 1> w;
+    for (int i=0; i!=9; ++i)
+        w.push_back(std::to_string(i));
+    REQUIRE_FALSE(w.settled());
+    w.pop_back();
+    w.pop_back();
+    REQUIRE(w.size() == 7);
+    REQUIRE(w[6] == "6");
+    w.settle();
+    REQUIRE(w.settled());
+    REQUIRE(w[3] == "3");
+
+    IncrementalVector<std::string> copy{v};
+    REQUIRE(std::equal(copy.begin(), copy.end(), v.begin()));
+
+    IncrementalVector<std::string> moved{std::move(copy)};
+    REQUIRE(copy.empty());
+    REQUIRE(moved.size() == 104);
+
+    copy = moved;
+    REQUIRE(copy[50] == "47");
+
+    v.clear();
+    REQUIRE(v.empty());
+    REQUIRE(v.settled());
+}
+
+TEST_CASE ("incrementalVectorPmrAllocators") {
+    using PmrIncrementalVector = IncrementalVector<int, std::pmr::polymorphic_allocator<int>, 2>;
+
+    std::pmr::unsynchronized_pool_resource pool;
+    PmrIncrementalVector a{&pool};
+    for (int i=0; i!=17; ++i)
+        a.push_back(i);
+    REQUIRE_FALSE(a.settled());
+
+    PmrIncrementalVector b{a};
+    REQUIRE(b.get_allocator().resource() == std::pmr::get_default_resource());
+
+    // move assignment across resources moves the elements, migrated or not
+    b = std::move(a);
+    REQUIRE(b.get_allocator().resource() == std::pmr::get_default_resource());
+    REQUIRE(b.size() == 17);
+    for (int i=0; i!=17; ++i)
+        REQUIRE(b[i] == i);
+    REQUIRE(a.empty());
+
+    // same resource: the buffers are swapped
+    PmrIncrementalVector c{&pool};
+    c.push_back(42);
+    a.push_back(7);
+    const int* first = &a[0];
+    c = std::move(a);
+    REQUIRE(&c[0] == first);
+
+    PmrIncrementalVector d{&pool};
+    c.swap(d);
+    REQUIRE(d.size() == 1);
+    REQUIRE(d[0] == 7);
+    REQUIRE(c.get_allocator().resource() == &pool);
+}
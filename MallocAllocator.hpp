@@ -0,0 +1,60 @@
+#ifndef MALLOC_ALLOCATOR_HPP
+#define MALLOC_ALLOCATOR_HPP
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+namespace tutorial {
+
+    // allocator on top of the C heap. Besides malloc/free it exposes calloc
+    // as allocate_zeroed, so zero-filled vectors of arithmetic types get
+    // lazily zeroed pages from the OS instead of a fill pass, and realloc
+    // as reallocate for trivially relocatable element types.
+    template <typename T>
+    struct MallocAllocator {
+        static_assert(alignof(T) <= alignof(std::max_align_t), "over-aligned types are not supported");
+
+        using value_type = T;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+
+        MallocAllocator() = default;
+
+        template <typename U>
+        MallocAllocator(const MallocAllocator<U>&) {}
+
+        T* allocate(size_type n) {
+            void* p = std::malloc(n*sizeof(T));
+            if (!p) throw std::bad_alloc{};
+
+            return static_cast<T*>(p);
+        }
+
+        T* allocate_zeroed(size_type n) {
+            void* p = std::calloc(n, sizeof(T));
+            if (!p) throw std::bad_alloc{};
+
+            return static_cast<T*>(p);
+        }
+
+        T* reallocate(T* p, size_type, size_type new_n) {
+            void* q = std::realloc(p, new_n*sizeof(T));
+            if (!q) throw std::bad_alloc{};
+
+            return static_cast<T*>(q);
+        }
+
+        void deallocate(T* p, size_type) {
+            std::free(p);
+        }
+    };
+
+    template <typename T, typename U>
+    bool operator==(const MallocAllocator<T>&, const MallocAllocator<U>&) { return true; }
+
+    template <typename T, typename U>
+    bool operator!=(const MallocAllocator<T>&, const MallocAllocator<U>&) { return false; }
+}
+
+#endif
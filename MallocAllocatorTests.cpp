@@ -0,0 +1,63 @@
+#include "catch.hpp"
+#include "Vector.hpp"
+#include "MallocAllocator.hpp"
+#include <string>
+
+using namespace tutorial;
+
+namespace {
+    enum class Color { red, green };
+
+    // counts the zeroed allocations made on behalf of the vector
+    template <typename T>
+    struct ZeroCountingAllocator : MallocAllocator<T> {
+        ZeroCountingAllocator() = default;
+
+        template <typename U>
+        ZeroCountingAllocator(const ZeroCountingAllocator<U>&) {}
+
+        T* allocate_zeroed(std::size_t n) {
+            ++zeroed;
+            return MallocAllocator<T>::allocate_zeroed(n);
+        }
+
+        static int zeroed;
+    };
+
+    template <typename T> int ZeroCountingAllocator<T>::zeroed = 0;
+}
+
+TEST_CASE ("zeroedConstruction") {
+    static_assert(is_zero_initializable_v<double>, "");
+    static_assert(is_zero_initializable_v<Color>, "");
+    static_assert(!is_zero_initializable_v<std::string>, "");
+    static_assert(has_allocate_zeroed_v<MallocAllocator<int>>, "");
+
+    // the buffer comes zeroed from the allocator instead of being filled
+    ZeroCountingAllocator<int>::zeroed = 0;
+    Vector<int, ZeroCountingAllocator<int>> v(1 << 20);
+    REQUIRE(ZeroCountingAllocator<int>::zeroed == 1);
+    REQUIRE(v.size() == 1 << 20);
+    REQUIRE(std::all_of(v.begin(), v.end(), [](int x) { return x == 0; }));
+
+    ZeroCountingAllocator<double>::zeroed = 0;
+    Vector<double, ZeroCountingAllocator<double>> d;
+    d.resize(1000);
+    REQUIRE(ZeroCountingAllocator<double>::zeroed == 1);
+    REQUIRE(std::all_of(d.begin(), d.end(), [](double x) { return x == 0.0; }));
+
+    // growing a non-empty vector still value-initializes the tail
+    d.push_back(1.0);
+    d.resize(5000);
+    REQUIRE(*(d.begin()+1000) == 1.0);
+    REQUIRE(*(d.end()-1) == 0.0);
+}
+
+TEST_CASE ("mallocAllocatorNonTrivial") {
+    Vector<std::string, MallocAllocator<std::string>> v(10);
+    v.push_back("x");
+
+    REQUIRE(v.size() == 11);
+    REQUIRE((v.begin()+3)->empty());
+    REQUIRE(*(v.end()-1) == "x");
+}
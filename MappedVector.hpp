@@ -0,0 +1,159 @@
+#ifndef MAPPED_VECTOR_HPP
+#define MAPPED_VECTOR_HPP
+
+#include "VectorFile.hpp"
+#include <cerrno>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace tutorial {
+
+    // read-only vector over a file in the VectorFileHeader format. The file
+    // is mapped, not read: opening is O(1) and the pages are shared through
+    // the page cache by every process mapping the same file.
+    template <typename T>
+    class MappedVector {
+        static_assert(std::is_trivially_copyable_v<T>, "only trivially copyable types can be mapped");
+
+    public:
+        using size_type = std::size_t;
+        using iterator = const T*;
+        using const_iterator = const T*;
+        using value_type = T;
+
+        explicit MappedVector(const std::string& path);
+        ~MappedVector();
+
+        MappedVector(const MappedVector&) =delete;
+        MappedVector& operator=(const MappedVector&) =delete;
+
+        // move operations
+        MappedVector(MappedVector&& a);
+        MappedVector& operator=(MappedVector&& a);
+
+        size_type size() const;
+        bool empty() const;
+
+        const T& operator[](size_type i) const;
+
+        const_iterator begin() const;
+        const_iterator end() const;
+
+    private:
+        void unmap();
+
+        void* map_ = nullptr;
+        size_type map_len_ = 0;
+        const T* elem_ = nullptr;
+        size_type size_ = 0;
+    };
+
+    template <typename T>
+    MappedVector<T>::MappedVector(const std::string& path) {
+        int fd = open(path.c_str(), O_RDONLY|O_CLOEXEC);
+        if (fd<0) throw std::system_error{errno, std::generic_category(), path};
+
+        struct stat st;
+        if (fstat(fd, &st)<0) {
+            int err = errno;
+            close(fd);
+            throw std::system_error{err, std::generic_category(), path};
+        }
+
+        map_len_ = st.st_size;
+        if (map_len_ < sizeof(VectorFileHeader)) {
+            close(fd);
+            throw std::runtime_error{"vector file is truncated"};
+        }
+
+        map_ = mmap(nullptr, map_len_, PROT_READ, MAP_SHARED, fd, 0);
+        int err = errno;
+        close(fd);
+        if (map_==MAP_FAILED) {
+            map_ = nullptr;
+            throw std::system_error{err, std::generic_category(), path};
+        }
+
+        try {
+            VectorFileHeader h;
+            std::memcpy(&h, map_, sizeof(h));
+            validate_vector_file_header<T>(h, map_len_);
+
+            elem_ = reinterpret_cast<const T*>(static_cast<const char*>(map_)+h.data_offset);
+            size_ = h.count;
+        }
+        catch (...) {
+            unmap();
+            throw;
+        }
+    }
+
+    template <typename T>
+    MappedVector<T>::~MappedVector() {
+        unmap();
+    }
+
+    template <typename T>
+    MappedVector<T>::MappedVector(MappedVector&& a):
+        map_{a.map_},
+        map_len_{a.map_len_},
+        elem_{a.elem_},
+        size_{a.size_}
+    {
+        a.map_ = nullptr;
+        a.map_len_ = 0;
+        a.elem_ = nullptr;
+        a.size_ = 0;
+    }
+
+    template <typename T>
+    MappedVector<T>& MappedVector<T>::operator=(MappedVector&& a) {
+        std::swap(map_, a.map_);
+        std::swap(map_len_, a.map_len_);
+        std::swap(elem_, a.elem_);
+        std::swap(size_, a.size_);
+
+        return *this;
+    }
+
+    template <typename T>
+    typename MappedVector<T>::size_type MappedVector<T>::size() const {
+        return size_;
+    }
+
+    template <typename T>
+    bool MappedVector<T>::empty() const {
+        return size_==0;
+    }
+
+    template <typename T>
+    const T& MappedVector<T>::operator[](size_type i) const {
+        return elem_[i];
+    }
+
+    template <typename T>
+    typename MappedVector<T>::const_iterator MappedVector<T>::begin() const {
+        return elem_;
+    }
+
+    template <typename T>
+    typename MappedVector<T>::const_iterator MappedVector<T>::end() const {
+        return elem_+size_;
+    }
+
+    template <typename T>
+    void MappedVector<T>::unmap() {
+        if (map_) munmap(map_, map_len_);
+        map_ = nullptr;
+        map_len_ = 0;
+        elem_ = nullptr;
+        size_ = 0;
+    }
+}
+
+#endif
@@ -0,0 +1,66 @@
+#include "catch.hpp"
+#include "MappedVector.hpp"
+#include "Vector.hpp"
+#include <cstdio>
+#include <cstdlib>
+
+using namespace tutorial;
+
+namespace {
+    // writes a vector file by hand and removes it when done
+    struct TempVectorFile {
+        template <typename T>
+        TempVectorFile(const VectorFileHeader& h, const Vector<T>& v) {
+            char name[] = "/tmp/mapped_vector_XXXXXX";
+            int fd = mkstemp(name);
+            path = name;
+
+            char header[VectorFileHeader::default_offset] = {};
+            std::memcpy(header, &h, sizeof(h));
+            ssize_t ok = write(fd, header, sizeof(header));
+            ok = write(fd, v.begin(), v.size()*sizeof(T));
+            (void)ok;
+            close(fd);
+        }
+
+        ~TempVectorFile() { std::remove(path.c_str()); }
+
+        std::string path;
+    };
+}
+
+TEST_CASE ("mappedVectorReadsFile") {
+    Vector<std::uint64_t> ids;
+    for (std::uint64_t i=0; i!=10000; ++i)
+        ids.push_back(i*3);
+
+    TempVectorFile file{make_vector_file_header<std::uint64_t>(ids.size()), ids};
+    MappedVector<std::uint64_t> m{file.path};
+
+    REQUIRE(m.size() == 10000);
+    REQUIRE(m[9999] == 29997);
+    REQUIRE(std::equal(m.begin(), m.end(), ids.begin()));
+
+    MappedVector<std::uint64_t> moved{std::move(m)};
+    REQUIRE(m.empty());
+    REQUIRE(moved.size() == 10000);
+}
+
+TEST_CASE ("mappedVectorValidatesHeader") {
+    Vector<int> v(100, 1);
+
+    VectorFileHeader h = make_vector_file_header<int>(v.size());
+    TempVectorFile good{h, v};
+    REQUIRE_THROWS_AS(MappedVector<double>{good.path}, std::runtime_error);
+
+    h.count = 1000;
+    TempVectorFile truncated{h, v};
+    REQUIRE_THROWS_AS(MappedVector<int>{truncated.path}, std::runtime_error);
+
+    h = make_vector_file_header<int>(v.size());
+    h.magic[0] = 'X';
+    TempVectorFile bad_magic{h, v};
+    REQUIRE_THROWS_AS(MappedVector<int>{bad_magic.path}, std::runtime_error);
+
+    REQUIRE_THROWS_AS(MappedVector<int>{"/nonexistent/file"}, std::system_error);
+}
@@ -0,0 +1,132 @@
+#ifndef MMAP_ALLOCATOR_HPP
+#define MMAP_ALLOCATOR_HPP
+
+#include <cstddef>
+#include <new>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace tutorial {
+
+    // MmapAllocator flags for latency-sensitive code
+    enum MmapFlags : unsigned {
+        mmap_populate = 1,  // fault every page in before returning
+        mmap_lock = 2       // also mlock the pages, best effort: this fails
+                            // quietly past RLIMIT_MEMLOCK
+    };
+
+    // allocates each block as its own anonymous mapping. Meant for large
+    // buffers: on Linux a block can be grown with mremap, which moves the
+    // pages instead of copying their contents.
+    template <typename T, unsigned Flags = 0>
+    struct MmapAllocator {
+        using value_type = T;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+
+        template <typename U>
+        struct rebind { using other = MmapAllocator<U, Flags>; };
+
+        MmapAllocator() = default;
+
+        template <typename U>
+        MmapAllocator(const MmapAllocator<U, Flags>&) {}
+
+        T* allocate(size_type n) {
+            if (n==0) return nullptr;
+
+            int flags = MAP_PRIVATE|MAP_ANONYMOUS;
+            bool populated = false;
+#ifdef MAP_POPULATE
+            if (Flags & (mmap_populate|mmap_lock)) {
+                flags |= MAP_POPULATE;
+                populated = true;
+            }
+#endif
+
+            void* p = mmap(nullptr, bytes(n), PROT_READ|PROT_WRITE, flags, -1, 0);
+            if (p==MAP_FAILED) throw std::bad_alloc{};
+
+            commit(static_cast<char*>(p), bytes(n), !populated);
+            return static_cast<T*>(p);
+        }
+
+        // fresh anonymous mappings are already zero filled
+        T* allocate_zeroed(size_type n) {
+            return allocate(n);
+        }
+
+        void deallocate(T* p, size_type n) {
+            if (p) munmap(p, bytes(n));
+        }
+
+#ifdef __linux__
+        // grows or shrinks the block at p, possibly moving it. The contents
+        // are preserved bytewise, so only use it for trivially relocatable T.
+        T* reallocate(T* p, size_type old_n, size_type new_n) {
+            if (!p) return allocate(new_n);
+            if (new_n==0) {
+                deallocate(p, old_n);
+                return nullptr;
+            }
+
+            void* q = mremap(p, bytes(old_n), bytes(new_n), MREMAP_MAYMOVE);
+            if (q==MAP_FAILED) throw std::bad_alloc{};
+
+            commit_tail(static_cast<char*>(q), old_n, new_n);
+            return static_cast<T*>(q);
+        }
+
+        // grows the block at p only if the pages after it are free
+        bool try_expand(T* p, size_type old_n, size_type new_n) {
+            if (bytes(new_n)==bytes(old_n)) return true;
+
+            if (mremap(p, bytes(old_n), bytes(new_n), 0)==MAP_FAILED) return false;
+
+            commit_tail(reinterpret_cast<char*>(p), old_n, new_n);
+            return true;
+        }
+#endif
+
+        static size_type bytes(size_type n) {
+            static const size_type page = sysconf(_SC_PAGESIZE);
+            return (n*sizeof(T)+page-1) / page * page;
+        }
+
+    private:
+        // makes [p, p+len) resident according to Flags
+        static void commit(char* p, size_type len, bool touch) {
+            if (touch && (Flags & (mmap_populate|mmap_lock))) {
+                static const size_type page = sysconf(_SC_PAGESIZE);
+
+                // the range is fresh, writing zeros doesn't change it
+                for (size_type i = 0; i<len; i += page)
+                    static_cast<volatile char*>(p)[i] = 0;
+            }
+
+            if (Flags & mmap_lock)
+                mlock(p, len);
+        }
+
+        static void commit_tail(char* p, size_type old_n, size_type new_n) {
+            if (bytes(new_n) > bytes(old_n))
+                commit(p+bytes(old_n), bytes(new_n)-bytes(old_n), true);
+        }
+    };
+
+    template <typename T, typename U, unsigned Flags>
+    bool operator==(const MmapAllocator<T, Flags>&, const MmapAllocator<U, Flags>&) { return true; }
+
+    template <typename T, typename U, unsigned Flags>
+    bool operator!=(const MmapAllocator<T, Flags>&, const MmapAllocator<U, Flags>&) { return false; }
+
+    // allocators whose capacity is resident as soon as reserve returns, so
+    // the first write to it never page faults
+    template <typename T>
+    using PrefaultedAllocator = MmapAllocator<T, mmap_populate>;
+
+    template <typename T>
+    using LockedAllocator = MmapAllocator<T, mmap_populate|mmap_lock>;
+}
+
+#endif
@@ -0,0 +1,75 @@
+#include "catch.hpp"
+#include "Vector.hpp"
+#include "MmapAllocator.hpp"
+#include <string>
+#include <vector>
+
+using namespace tutorial;
+
+TEST_CASE ("mmapBackedGrowth") {
+    Vector<int, MmapAllocator<int>> v;
+
+    for (int i=0; i!=1000000; ++i)
+        v.push_back(i);
+
+    REQUIRE(v.size() == 1000000);
+
+    bool ok = true;
+    int i = 0;
+    for (int x : v)
+        ok = ok && x == i++;
+    REQUIRE(ok);
+
+    v.reserve(4000000);
+    REQUIRE(v.capacity() == 4000000);
+    REQUIRE(*(v.begin()+999999) == 999999);
+}
+
+TEST_CASE ("mmapAllocatorWithoutRelocation") {
+    // non trivially relocatable types take the regular copy path
+    Vector<std::string, MmapAllocator<std::string>> v;
+
+    for (int i=0; i!=1000; ++i)
+        v.push_back(std::to_string(i));
+
+    REQUIRE(v.size() == 1000);
+    REQUIRE(*(v.begin()+500) == "500");
+}
+
+namespace {
+    // number of resident pages in [p, p+len)
+    std::size_t resident_pages(const void* p, std::size_t len) {
+        std::size_t page = sysconf(_SC_PAGESIZE);
+        std::size_t pages = (len+page-1)/page;
+        std::vector<unsigned char> status(pages);
+
+        mincore(const_cast<void*>(p), len, status.data());
+        return std::count_if(status.begin(), status.end(), [](unsigned char s) { return s & 1; });
+    }
+}
+
+TEST_CASE ("prefaultedReserve") {
+    std::size_t page = sysconf(_SC_PAGESIZE);
+    std::size_t n = 64*page/sizeof(int);
+
+    Vector<int, PrefaultedAllocator<int>> v;
+    v.reserve(n);
+    REQUIRE(resident_pages(v.begin(), n*sizeof(int)) == 64);
+
+    // the part added by growing is prefaulted too
+    v.resize(n);
+    v.reserve(2*n);
+    REQUIRE(resident_pages(v.begin(), 2*n*sizeof(int)) == 128);
+
+    Vector<int, MmapAllocator<int>> lazy;
+    lazy.reserve(n);
+    REQUIRE(resident_pages(lazy.begin(), n*sizeof(int)) == 0);
+}
+
+TEST_CASE ("lockedReserve") {
+    Vector<char, LockedAllocator<char>> v;
+    v.reserve(16*1024);
+    v.push_back('x');
+
+    REQUIRE(resident_pages(v.begin(), 16*1024) == 16*1024/sysconf(_SC_PAGESIZE));
+}
@@ -0,0 +1,169 @@
+#ifndef RECYCLING_ALLOCATOR_HPP
+#define RECYCLING_ALLOCATOR_HPP
+
+#include "Vector.hpp"
+#include <new>
+
+namespace tutorial {
+
+    struct RecyclerStats {
+        std::size_t hits = 0;         // allocations served from the cache
+        std::size_t misses = 0;       // allocations that went to operator new
+        std::size_t recycled = 0;     // blocks kept in the cache on deallocate
+        std::size_t released = 0;     // blocks handed back to operator delete
+        std::size_t cached_bytes = 0; // bytes currently held by the cache
+    };
+
+    // per-thread cache of freed blocks, bucketed by power-of-two size. Blocks
+    // freed on another thread simply join that thread's cache. The cache
+    // holds at most limit() bytes; anything past that, and any block larger
+    // than 1 << max_class bytes, goes straight back to operator delete.
+    class RecyclerCache {
+    public:
+        static constexpr std::size_t min_class = 4;
+        static constexpr std::size_t max_class = 20;
+
+        static RecyclerCache& local();
+
+        RecyclerCache() = default;
+        ~RecyclerCache();
+
+        RecyclerCache(const RecyclerCache&) =delete;
+        RecyclerCache& operator=(const RecyclerCache&) =delete;
+
+        void* allocate(std::size_t bytes);
+        void deallocate(void* p, std::size_t bytes);
+
+        // returns every cached block to operator delete
+        void trim();
+
+        std::size_t limit() const;
+        void set_limit(std::size_t bytes);
+
+        const RecyclerStats& stats() const;
+
+    private:
+        struct Node {
+            Node* next;
+        };
+
+        static std::size_t size_class(std::size_t bytes);
+
+        Node* free_[max_class+1] = {};
+        std::size_t limit_ = std::size_t(8) << 20;
+        RecyclerStats stats_;
+    };
+
+    inline RecyclerCache& RecyclerCache::local() {
+        static thread_local RecyclerCache cache;
+        return cache;
+    }
+
+    inline RecyclerCache::~RecyclerCache() {
+        trim();
+    }
+
+    inline void* RecyclerCache::allocate(std::size_t bytes) {
+        std::size_t c = size_class(bytes);
+        if (c > max_class) return ::operator new(bytes);
+
+        if (Node* n = free_[c]) {
+            free_[c] = n->next;
+            stats_.cached_bytes -= std::size_t(1) << c;
+            ++stats_.hits;
+            return n;
+        }
+
+        ++stats_.misses;
+        return ::operator new(std::size_t(1) << c);
+    }
+
+    inline void RecyclerCache::deallocate(void* p, std::size_t bytes) {
+        std::size_t c = size_class(bytes);
+        if (c > max_class) {
+            ::operator delete(p);
+            return;
+        }
+
+        std::size_t block = std::size_t(1) << c;
+        if (stats_.cached_bytes+block > limit_) {
+            ++stats_.released;
+            ::operator delete(p);
+            return;
+        }
+
+        free_[c] = new (p) Node{free_[c]};
+        stats_.cached_bytes += block;
+        ++stats_.recycled;
+    }
+
+    inline void RecyclerCache::trim() {
+        for (Node*& head : free_) {
+            while (head) {
+                Node* next = head->next;
+                ::operator delete(head);
+                head = next;
+            }
+        }
+        stats_.cached_bytes = 0;
+    }
+
+    inline std::size_t RecyclerCache::limit() const {
+        return limit_;
+    }
+
+    inline void RecyclerCache::set_limit(std::size_t bytes) {
+        limit_ = bytes;
+        if (stats_.cached_bytes > limit_) trim();
+    }
+
+    inline const RecyclerStats& RecyclerCache::stats() const {
+        return stats_;
+    }
+
+    inline std::size_t RecyclerCache::size_class(std::size_t bytes) {
+        if (bytes <= (std::size_t(1) << min_class)) return min_class;
+
+#if defined(__GNUC__)
+        return 64-__builtin_clzll(static_cast<unsigned long long>(bytes-1));
+#else
+        std::size_t c = min_class;
+        while ((std::size_t(1) << c) < bytes)
+            ++c;
+        return c;
+#endif
+    }
+
+    // allocator backed by the calling thread's RecyclerCache, so vectors
+    // of similar capacities reuse each other's buffers without touching
+    // the global heap
+    template <typename T>
+    struct RecyclingAllocator {
+        static_assert(alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__,
+                      "over-aligned types are not supported");
+
+        using value_type = T;
+        using size_type = std::size_t;
+
+        RecyclingAllocator() = default;
+
+        template <typename U>
+        RecyclingAllocator(const RecyclingAllocator<U>&) {}
+
+        T* allocate(size_type n) {
+            return static_cast<T*>(RecyclerCache::local().allocate(n*sizeof(T)));
+        }
+
+        void deallocate(T* p, size_type n) {
+            RecyclerCache::local().deallocate(p, n*sizeof(T));
+        }
+    };
+
+    template <typename T, typename U>
+    bool operator==(const RecyclingAllocator<T>&, const RecyclingAllocator<U>&) { return true; }
+
+    template <typename T, typename U>
+    bool operator!=(const RecyclingAllocator<T>&, const RecyclingAllocator<U>&) { return false; }
+}
+
+#endif
@@ -0,0 +1,54 @@
+#include "catch.hpp"
+#include "RecyclingAllocator.hpp"
+#include <thread>
+
+using namespace tutorial;
+
+TEST_CASE ("recyclerReusesBuffers") {
+    RecyclerCache& cache = RecyclerCache::local();
+    cache.trim();
+    RecyclerStats before = cache.stats();
+
+    for (int round=0; round!=10; ++round) {
+        Vector<int, RecyclingAllocator<int>> v;
+        v.reserve(1000);
+        for (int i=0; i!=1000; ++i)
+            v.push_back(i);
+        REQUIRE(*(v.begin()+999) == 999);
+    }
+
+    // only the first round had to go to the heap
+    REQUIRE(cache.stats().misses-before.misses == 1);
+    REQUIRE(cache.stats().hits-before.hits == 9);
+    REQUIRE(cache.stats().cached_bytes == 4096);
+}
+
+TEST_CASE ("recyclerCacheIsBounded") {
+    RecyclerCache& cache = RecyclerCache::local();
+    cache.trim();
+    std::size_t limit = cache.limit();
+    cache.set_limit(1024);
+
+    {
+        Vector<char, RecyclingAllocator<char>> a(1024, 'a');
+        Vector<char, RecyclingAllocator<char>> b(1024, 'b');
+    }
+
+    REQUIRE(cache.stats().cached_bytes == 1024);
+
+    cache.set_limit(limit);
+}
+
+TEST_CASE ("recyclerCachesArePerThread") {
+    RecyclerStats other;
+
+    std::thread t{[&] {
+        Vector<int, RecyclingAllocator<int>> v(100);
+        v.clear();
+        other = RecyclerCache::local().stats();
+    }};
+    t.join();
+
+    REQUIRE(other.misses == 1);
+    REQUIRE(other.hits == 0);
+}
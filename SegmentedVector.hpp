@@ -0,0 +1,391 @@
+#ifndef SEGMENTED_VECTOR_HPP
+#define SEGMENTED_VECTOR_HPP
+
+#include "Vector.hpp"
+#include <algorithm>
+#include <iterator>
+
+namespace tutorial {
+
+    constexpr std::size_t log2_floor(std::size_t n) {
+#if defined(__GNUC__)
+        return 63-__builtin_clzll(static_cast<unsigned long long>(n));
+#else
+        std::size_t k = 0;
+        while (n >>= 1)
+            ++k;
+        return k;
+#endif
+    }
+
+    // random access iterator over a SegmentedVector, or any container
+    // whose elements are reached through operator[]. V is the (possibly
+    // const) container and R the element type it yields
+    template <typename V, typename R>
+    class SegmentedIterator {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = std::remove_const_t<R>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = R*;
+        using reference = R&;
+
+        SegmentedIterator() = default;
+        SegmentedIterator(V* v, std::size_t i): v_{v}, i_{i} {}
+
+        // iterator to const_iterator
+        template <typename W, typename S, typename = std::enable_if_t<std::is_convertible_v<S*, R*>>>
+        SegmentedIterator(const SegmentedIterator<W,S>& a): v_{a.v_}, i_{a.i_} {}
+
+        reference operator*() const { return (*v_)[i_]; }
+        pointer operator->() const { return &(*v_)[i_]; }
+        reference operator[](difference_type n) const { return (*v_)[i_+n]; }
+
+        SegmentedIterator& operator++() { ++i_; return *this; }
+        SegmentedIterator& operator--() { --i_; return *this; }
+        SegmentedIterator operator++(int) { SegmentedIterator t = *this; ++i_; return t; }
+        SegmentedIterator operator--(int) { SegmentedIterator t = *this; --i_; return t; }
+
+        SegmentedIterator& operator+=(difference_type n) { i_ += n; return *this; }
+        SegmentedIterator& operator-=(difference_type n) { i_ -= n; return *this; }
+
+        friend SegmentedIterator operator+(SegmentedIterator a, difference_type n) { return a += n; }
+        friend SegmentedIterator operator+(difference_type n, SegmentedIterator a) { return a += n; }
+        friend SegmentedIterator operator-(SegmentedIterator a, difference_type n) { return a -= n; }
+
+        friend difference_type operator-(const SegmentedIterator& a, const SegmentedIterator& b) {
+            return difference_type(a.i_)-difference_type(b.i_);
+        }
+
+        friend bool operator==(const SegmentedIterator& a, const SegmentedIterator& b) { return a.i_==b.i_; }
+        friend bool operator!=(const SegmentedIterator& a, const SegmentedIterator& b) { return a.i_!=b.i_; }
+        friend bool operator<(const SegmentedIterator& a, const SegmentedIterator& b) { return a.i_<b.i_; }
+        friend bool operator>(const SegmentedIterator& a, const SegmentedIterator& b) { return a.i_>b.i_; }
+        friend bool operator<=(const SegmentedIterator& a, const SegmentedIterator& b) { return a.i_<=b.i_; }
+        friend bool operator>=(const SegmentedIterator& a, const SegmentedIterator& b) { return a.i_>=b.i_; }
+
+    private:
+        template <typename W, typename S> friend class SegmentedIterator;
+
+        V* v_ = nullptr;
+        std::size_t i_ = 0;
+    };
+
+    // vector made of blocks that are never moved: block k holds
+    // FirstBlock << k elements, so the blocks double in size and the block
+    // holding any index is found with one count-leading-zeros. Appending
+    // allocates at most one new block and never copies, so its worst case
+    // does not depend on the size. The block directory is a fixed array.
+    template <typename T, typename A = std::allocator<T>, std::size_t FirstBlock = 16>
+    class SegmentedVector {
+        static_assert(FirstBlock && (FirstBlock & (FirstBlock-1))==0, "FirstBlock must be a power of two");
+
+    public:
+        using size_type = typename std::allocator_traits<A>::size_type;
+        using allocator_type = A;
+        using iterator = SegmentedIterator<SegmentedVector, T>;
+        using const_iterator = SegmentedIterator<const SegmentedVector, const T>;
+        using value_type = T;
+
+        explicit SegmentedVector(const A& = A());
+        SegmentedVector(std::initializer_list<value_type> data, const A& = A());
+        ~SegmentedVector();
+
+        // copy operations
+        SegmentedVector(const SegmentedVector& rhs);
+        SegmentedVector& operator=(const SegmentedVector& rhs);
+
+        // move operations
+        SegmentedVector(SegmentedVector&& a);
+        SegmentedVector& operator=(SegmentedVector&& a);
+
+        void swap(SegmentedVector& a);
+        allocator_type get_allocator() const;
+
+        size_type size() const;
+        size_type capacity() const;
+
+        bool empty() const;
+        void destroy();
+
+        void reserve(size_type n);
+        void clear();
+        void push_back(const T&);
+        void push_back(T&&);
+        void pop_back();
+
+        template <typename... Args>
+        T& emplace_back(Args&&... args);
+
+        T& operator[](size_type i);
+        const T& operator[](size_type i) const;
+
+        iterator begin();
+        const_iterator begin() const;
+
+        iterator end();
+        const_iterator end() const;
+
+        // contiguous copy of the elements, one block at a time
+        Vector<T,A> flatten() const;
+
+    private:
+        using traits = std::allocator_traits<A>;
+
+        static constexpr std::size_t shift = log2_floor(FirstBlock);
+        static constexpr std::size_t max_blocks = 64-shift;
+
+        static constexpr size_type block_size(std::size_t k) { return size_type(FirstBlock) << k; }
+        static constexpr size_type block_start(std::size_t k) { return (block_size(k)-FirstBlock); }
+
+        // block holding index i
+        static std::size_t block_of(size_type i);
+
+        void add_block();
+
+        // gives every block back to the allocator, the vector must be empty
+        void deallocate();
+
+        A alloc_;
+        T* blocks_[max_blocks] = {};
+        std::size_t nblocks_ = 0;
+        size_type sz_ = 0;
+    };
+
+    template <typename T, typename A, std::size_t FirstBlock>
+    SegmentedVector<T,A,FirstBlock>::SegmentedVector(const A& a):
+        alloc_{a}
+    {}
+
+    template <typename T, typename A, std::size_t FirstBlock>
+    SegmentedVector<T,A,FirstBlock>::SegmentedVector(std::initializer_list<value_type> data, const A& a):
+        alloc_{a}
+    {
+        reserve(data.size());
+        for (const T& x : data)
+            emplace_back(x);
+    }
+
+    template <typename T, typename A, std::size_t FirstBlock>
+    SegmentedVector<T,A,FirstBlock>::~SegmentedVector() {
+        destroy();
+        deallocate();
+    }
+
+    template <typename T, typename A, std::size_t FirstBlock>
+    SegmentedVector<T,A,FirstBlock>::SegmentedVector(const SegmentedVector& rhs):
+        alloc_{traits::select_on_container_copy_construction(rhs.alloc_)}
+    {
+        reserve(rhs.size());
+        for (const T& x : rhs)
+            emplace_back(x);
+    }
+
+    template <typename T, typename A, std::size_t FirstBlock>
+    SegmentedVector<T,A,FirstBlock>& SegmentedVector<T,A,FirstBlock>::operator=(const SegmentedVector& rhs) {
+        if (&rhs == this) return *this;
+
+        // reuse the blocks already allocated
+        destroy();
+
+        if constexpr (traits::propagate_on_container_copy_assignment::value) {
+            if (alloc_!=rhs.alloc_) {
+                // the blocks belong to the old allocator, release them first
+                deallocate();
+                alloc_ = rhs.alloc_;
+            }
+        }
+
+        reserve(rhs.size());
+        for (const T& x : rhs)
+            emplace_back(x);
+
+        return *this;
+    }
+
+    template <typename T, typename A, std::size_t FirstBlock>
+    SegmentedVector<T,A,FirstBlock>::SegmentedVector(SegmentedVector&& a):
+        alloc_{a.alloc_},
+        nblocks_{a.nblocks_},
+        sz_{a.sz_}
+    {
+        std::copy(a.blocks_, a.blocks_+a.nblocks_, blocks_);
+        a.nblocks_ = 0;
+        a.sz_ = 0;
+    }
+
+    template <typename T, typename A, std::size_t FirstBlock>
+    SegmentedVector<T,A,FirstBlock>& SegmentedVector<T,A,FirstBlock>::operator=(SegmentedVector&& a) {
+        if (&a == this) return *this;
+
+        if constexpr (traits::propagate_on_container_move_assignment::value) {
+            std::swap(alloc_, a.alloc_);
+        }
+        else if constexpr (!traits::is_always_equal::value) {
+            if (alloc_!=a.alloc_) {
+                // a's blocks can't be adopted, move the elements instead
+                destroy();
+                reserve(a.size());
+                for (T& x : a)
+                    emplace_back(std::move(x));
+                a.destroy();
+
+                return *this;
+            }
+        }
+
+        // swap representations
+        std::swap(blocks_, a.blocks_);
+        std::swap(nblocks_, a.nblocks_);
+        std::swap(sz_, a.sz_);
+
+        return *this;
+    }
+
+    template <typename T, typename A, std::size_t FirstBlock>
+    void SegmentedVector<T,A,FirstBlock>::swap(SegmentedVector& a) {
+        // allocators are only exchanged if they propagate on swap,
+        // otherwise they must compare equal
+        if constexpr (traits::propagate_on_container_swap::value)
+            std::swap(alloc_, a.alloc_);
+        std::swap(blocks_, a.blocks_);
+        std::swap(nblocks_, a.nblocks_);
+        std::swap(sz_, a.sz_);
+    }
+
+    template <typename T, typename A, std::size_t FirstBlock>
+    typename SegmentedVector<T,A,FirstBlock>::allocator_type SegmentedVector<T,A,FirstBlock>::get_allocator() const {
+        return alloc_;
+    }
+
+    template <typename T, typename A, std::size_t FirstBlock>
+    typename SegmentedVector<T,A,FirstBlock>::size_type SegmentedVector<T,A,FirstBlock>::size() const {
+        return sz_;
+    }
+
+    template <typename T, typename A, std::size_t FirstBlock>
+    typename SegmentedVector<T,A,FirstBlock>::size_type SegmentedVector<T,A,FirstBlock>::capacity() const {
+        return block_start(nblocks_);
+    }
+
+    template <typename T, typename A, std::size_t FirstBlock>
+    bool SegmentedVector<T,A,FirstBlock>::empty() const {
+        return sz_==0;
+    }
+
+    template <typename T, typename A, std::size_t FirstBlock>
+    void SegmentedVector<T,A,FirstBlock>::destroy() {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            while (sz_)
+                pop_back();
+        }
+        sz_ = 0;
+    }
+
+    template <typename T, typename A, std::size_t FirstBlock>
+    void SegmentedVector<T,A,FirstBlock>::reserve(size_type n) {
+        while (capacity() < n)
+            add_block();
+    }
+
+    template <typename T, typename A, std::size_t FirstBlock>
+    void SegmentedVector<T,A,FirstBlock>::clear() {
+        destroy();
+    }
+
+    template <typename T, typename A, std::size_t FirstBlock>
+    void SegmentedVector<T,A,FirstBlock>::push_back(const T& val) {
+        emplace_back(val);
+    }
+
+    template <typename T, typename A, std::size_t FirstBlock>
+    void SegmentedVector<T,A,FirstBlock>::push_back(T&& val) {
+        emplace_back(std::move(val));
+    }
+
+    template <typename T, typename A, std::size_t FirstBlock>
+    void SegmentedVector<T,A,FirstBlock>::pop_back() {
+        --sz_;
+        (*this)[sz_].~T();
+    }
+
+    template <typename T, typename A, std::size_t FirstBlock>
+    template <typename... Args>
+    T& SegmentedVector<T,A,FirstBlock>::emplace_back(Args&&... args) {
+        // existing elements never move, so args may refer to one of them
+        if (sz_==capacity()) add_block();
+
+        T* p = &(*this)[sz_];
+        traits::construct(alloc_, p, std::forward<Args>(args)...);
+        ++sz_;
+        return *p;
+    }
+
+    template <typename T, typename A, std::size_t FirstBlock>
+    T& SegmentedVector<T,A,FirstBlock>::operator[](size_type i) {
+        std::size_t k = block_of(i);
+        return blocks_[k][i-block_start(k)];
+    }
+
+    template <typename T, typename A, std::size_t FirstBlock>
+    const T& SegmentedVector<T,A,FirstBlock>::operator[](size_type i) const {
+        std::size_t k = block_of(i);
+        return blocks_[k][i-block_start(k)];
+    }
+
+    template <typename T, typename A, std::size_t FirstBlock>
+    typename SegmentedVector<T,A,FirstBlock>::iterator SegmentedVector<T,A,FirstBlock>::begin() {
+        return iterator{this, 0};
+    }
+
+    template <typename T, typename A, std::size_t FirstBlock>
+    typename SegmentedVector<T,A,FirstBlock>::const_iterator SegmentedVector<T,A,FirstBlock>::begin() const {
+        return const_iterator{this, 0};
+    }
+
+    template <typename T, typename A, std::size_t FirstBlock>
+    typename SegmentedVector<T,A,FirstBlock>::iterator SegmentedVector<T,A,FirstBlock>::end() {
+        return iterator{this, sz_};
+    }
+
+    template <typename T, typename A, std::size_t FirstBlock>
+    typename SegmentedVector<T,A,FirstBlock>::const_iterator SegmentedVector<T,A,FirstBlock>::end() const {
+        return const_iterator{this, sz_};
+    }
+
+    template <typename T, typename A, std::size_t FirstBlock>
+    Vector<T,A> SegmentedVector<T,A,FirstBlock>::flatten() const {
+        Vector<T,A> v(alloc_);
+        v.reserve(sz_);
+
+        for (std::size_t k=0; k!=nblocks_ && block_start(k) < sz_; ++k) {
+            const T* first = blocks_[k];
+            v.append(first, first+std::min(block_size(k), sz_-block_start(k)));
+        }
+
+        return v;
+    }
+
+    template <typename T, typename A, std::size_t FirstBlock>
+    std::size_t SegmentedVector<T,A,FirstBlock>::block_of(size_type i) {
+        // block k covers [FirstBlock*(2^k-1), FirstBlock*(2^(k+1)-1))
+        return log2_floor((i >> shift)+1);
+    }
+
+    template <typename T, typename A, std::size_t FirstBlock>
+    void SegmentedVector<T,A,FirstBlock>::add_block() {
+        if (nblocks_==max_blocks) throw std::bad_alloc{};
+
+        blocks_[nblocks_] = traits::allocate(alloc_, block_size(nblocks_));
+        ++nblocks_;
+    }
+
+    template <typename T, typename A, std::size_t FirstBlock>
+    void SegmentedVector<T,A,FirstBlock>::deallocate() {
+        for (std::size_t k=0; k!=nblocks_; ++k)
+            traits::deallocate(alloc_, blocks_[k], block_size(k));
+        nblocks_ = 0;
+    }
+}
+
+#endif
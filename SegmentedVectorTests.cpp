@@ -0,0 +1,101 @@
+#include "catch.hpp"
+#include "SegmentedVector.hpp"
+#include <algorithm>
+#include <memory_resource>
+#include <string>
+
+using namespace tutorial;
+
+TEST_CASE ("segmentedVectorIndexing") {
+    SegmentedVector<int, std::allocator<int>, 4> v;
+    REQUIRE(v.capacity() == 0);
+
+    const int* first = nullptr;
+    for (int i=0; i!=1000; ++i) {
+        v.push_back(i);
+        if (i==0) first = &v[0];
+    }
+
+    // blocks of 4, 8, 16, ... elements, none of them ever moved
+    REQUIRE(&v[0] == first);
+    REQUIRE(v.capacity() == 1020);
+    for (int i=0; i!=1000; ++i)
+        REQUIRE(v[i] == i);
+
+    v.pop_back();
+    REQUIRE(v.size() == 999);
+}
+
+TEST_CASE ("segmentedVectorIterators") {
+    SegmentedVector<int> v;
+    for (int i=0; i!=500; ++i)
+        v.push_back(500-i);
+
+    auto it = v.begin()+100;
+    REQUIRE(*it == 400);
+    REQUIRE(it[10] == 390);
+    REQUIRE(v.end()-v.begin() == 500);
+
+    std::sort(v.begin(), v.end());
+    REQUIRE(std::is_sorted(v.begin(), v.end()));
+    REQUIRE(v[0] == 1);
+
+    const SegmentedVector<int>& cv = v;
+    SegmentedVector<int>::const_iterator cit = v.begin();
+    REQUIRE(cit == cv.begin());
+    REQUIRE(std::count(cv.begin(), cv.end(), 250) == 1);
+}
+
+TEST_CASE ("segmentedVectorFlatten") {
+    SegmentedVector<std::string> v{"a", "b"};
+    for (int i=0; i!=100; ++i)
+        v.push_back(std::to_string(i));
+
+    Vector<std::string> flat = v.flatten();
+    REQUIRE(flat.size() == 102);
+    REQUIRE(std::equal(flat.begin(), flat.end(), v.begin()));
+
+    SegmentedVector<std::string> copy{v};
+    SegmentedVector<std::string> moved{std::move(v)};
+    REQUIRE(v.empty());
+    REQUIRE(moved[101] == "99");
+
+    copy = moved;
+    REQUIRE(copy.size() == 102);
+
+    v.emplace_back("again");
+    REQUIRE(v[0] == "again");
+}
+
+TEST_CASE ("segmentedVectorPmrAllocators") {
+    using PmrSegmentedVector = SegmentedVector<int, std::pmr::polymorphic_allocator<int>>;
+
+    std::pmr::unsynchronized_pool_resource pool;
+    PmrSegmentedVector a{&pool};
+    for (int i=0; i!=100; ++i)
+        a.push_back(i);
+
+    PmrSegmentedVector b{a};
+    REQUIRE(b.get_allocator().resource() == std::pmr::get_default_resource());
+
+    // move assignment across resources moves the elements
+    b = std::move(a);
+    REQUIRE(b.get_allocator().resource() == std::pmr::get_default_resource());
+    REQUIRE(b.size() == 100);
+    REQUIRE(b[99] == 99);
+    REQUIRE(a.empty());
+
+    // same resource: the blocks are swapped
+    PmrSegmentedVector c{&pool};
+    c.push_back(42);
+    a.push_back(7);
+    const int* first = &a[0];
+    c = std::move(a);
+    REQUIRE(&c[0] == first);
+
+    PmrSegmentedVector d{&pool};
+    c.swap(d);
+    REQUIRE(d.size() == 1);
+    REQUIRE(d[0] == 7);
+    REQUIRE(c.get_allocator().resource() == &pool);
+}
@@ -0,0 +1,353 @@
+#ifndef SMALL_VECTOR_HPP
+#define SMALL_VECTOR_HPP
+
+#include "Vector.hpp"
+
+namespace tutorial {
+
+    // vector that stores up to N elements inside the object and only
+    // allocates once it grows past N. While the elements are inline, base_
+    // points into the inline buffer and must never be handed back to the
+    // allocator.
+    template <typename T, std::size_t N, typename A = std::allocator<T>, typename G = DoublingGrowth>
+    class SmallVector {
+        static_assert(N > 0, "use Vector when there is no inline storage");
+
+    public:
+        using size_type = typename std::allocator_traits<A>::size_type;
+        using allocator_type = A;
+        using iterator = T*;
+        using const_iterator = const T*;
+        using value_type = T;
+        using growth_policy = G;
+
+        explicit SmallVector(const A& = A());
+        explicit SmallVector(size_type n, const A& = A());
+        SmallVector(size_type n, const T& val, const A& = A());
+        SmallVector(std::initializer_list<value_type> data, const A& = A());
+
+        ~SmallVector();
+
+        // copy operations
+        SmallVector(const SmallVector& rhs);
+        SmallVector& operator=(const SmallVector& rhs);
+
+        // move operations
+        SmallVector(SmallVector&& a);
+        SmallVector& operator=(SmallVector&& a);
+
+        allocator_type get_allocator() const;
+
+        size_type size() const;
+        size_type capacity() const;
+
+        bool empty() const;
+        bool is_inline() const;
+        void destroy();
+
+        void reserve(size_type n);
+        void resize(size_type n);
+        void resize(size_type n, const T& val);
+        void clear();
+        void push_back(const T&);
+        void push_back(T&&);
+
+        template <typename... Args>
+        T& emplace_back(Args&&... args);
+
+        iterator begin();
+        const_iterator begin() const;
+
+        iterator end();
+        const_iterator end() const;
+
+    private:
+        using traits = std::allocator_traits<A>;
+
+        T* inline_begin();
+        const T* inline_begin() const;
+
+        // forget the inline buffer so ~VectorBase doesn't deallocate it
+        void release_inline(VectorBase<T,A>& b);
+
+        // give a heap buffer back to the allocator and go back to the
+        // inline one; the vector must be empty
+        void release_heap();
+
+        VectorBase<T,A> base_;
+        alignas(T) unsigned char inline_[N*sizeof(T)];
+    };
+
+    template <typename T, std::size_t N, typename A, typename G>
+    SmallVector<T,N,A,G>::SmallVector(const A& a):
+        base_{a, 0}
+    {
+        base_.elem = base_.space = inline_begin();
+        base_.last = base_.elem+N;
+    }
+
+    template <typename T, std::size_t N, typename A, typename G>
+    SmallVector<T,N,A,G>::SmallVector(size_type n, const A& a):
+        SmallVector(a)
+    {
+        resize(n);
+    }
+
+    template <typename T, std::size_t N, typename A, typename G>
+    SmallVector<T,N,A,G>::SmallVector(size_type n, const T& val, const A& a):
+        SmallVector(a)
+    {
+        resize(n, val);
+    }
+
+    template <typename T, std::size_t N, typename A, typename G>
+    SmallVector<T,N,A,G>::SmallVector(std::initializer_list<value_type> data, const A& a):
+        SmallVector(a)
+    {
+        reserve(data.size());
+        base_.space = std::uninitialized_copy(data.begin(), data.end(), base_.elem);
+    }
+
+    template <typename T, std::size_t N, typename A, typename G>
+    SmallVector<T,N,A,G>::~SmallVector() {
+        destroy();
+        if (is_inline()) release_inline(base_);
+    }
+
+    template <typename T, std::size_t N, typename A, typename G>
+    SmallVector<T,N,A,G>::SmallVector(const SmallVector& rhs):
+        SmallVector(traits::select_on_container_copy_construction(rhs.base_.alloc))
+    {
+        reserve(rhs.size());
+        base_.space = std::uninitialized_copy(rhs.begin(), rhs.end(), base_.elem);
+    }
+
+    template <typename T, std::size_t N, typename A, typename G>
+    SmallVector<T,N,A,G>& SmallVector<T,N,A,G>::operator=(const SmallVector& rhs) {
+        if (&rhs == this) return *this;
+
+        destroy();
+
+        if constexpr (traits::propagate_on_container_copy_assignment::value) {
+            if (base_.alloc!=rhs.base_.alloc) {
+                // the heap buffer belongs to the old allocator
+                release_heap();
+                base_.alloc = rhs.base_.alloc;
+            }
+        }
+
+        reserve(rhs.size());
+        base_.space = std::uninitialized_copy(rhs.begin(), rhs.end(), base_.elem);
+
+        return *this;
+    }
+
+    template <typename T, std::size_t N, typename A, typename G>
+    SmallVector<T,N,A,G>::SmallVector(SmallVector&& a):
+        SmallVector(a.base_.alloc)
+    {
+        *this = std::move(a);
+    }
+
+    template <typename T, std::size_t N, typename A, typename G>
+    SmallVector<T,N,A,G>& SmallVector<T,N,A,G>::operator=(SmallVector&& a) {
+        if (&a == this) return *this;
+
+        destroy();
+
+        if constexpr (traits::propagate_on_container_move_assignment::value) {
+            if (base_.alloc!=a.base_.alloc) {
+                // the heap buffer belongs to the old allocator
+                release_heap();
+                base_.alloc = a.base_.alloc;
+            }
+        }
+
+        bool adopt = !a.is_inline();
+        if constexpr (!traits::propagate_on_container_move_assignment::value && !traits::is_always_equal::value) {
+            // a's heap buffer can only be adopted if our allocator can free it
+            adopt = adopt && base_.alloc==a.base_.alloc;
+        }
+
+        if (!adopt) {
+            // the elements have to be moved one by one
+            reserve(a.size());
+            uninitialized_relocate(a.base_.elem, a.base_.space, base_.elem);
+            base_.space = base_.elem+a.size();
+            a.base_.space = a.base_.elem;
+        }
+        else {
+            // steal the heap buffer and leave a with its inline one
+            if (is_inline()) release_inline(base_);
+            VectorBase<T,A> old{std::move(base_)};
+            base_ = std::move(a.base_);
+            a.base_.elem = a.base_.space = a.inline_begin();
+            a.base_.last = a.base_.elem+N;
+        }
+
+        return *this;
+    }
+
+    template <typename T, std::size_t N, typename A, typename G>
+    typename SmallVector<T,N,A,G>::allocator_type SmallVector<T,N,A,G>::get_allocator() const {
+        return base_.alloc;
+    }
+
+    template <typename T, std::size_t N, typename A, typename G>
+    typename SmallVector<T,N,A,G>::size_type SmallVector<T,N,A,G>::size() const {
+        return base_.space-base_.elem;
+    }
+
+    template <typename T, std::size_t N, typename A, typename G>
+    typename SmallVector<T,N,A,G>::size_type SmallVector<T,N,A,G>::capacity() const {
+        return base_.last-base_.elem;
+    }
+
+    template <typename T, std::size_t N, typename A, typename G>
+    bool SmallVector<T,N,A,G>::empty() const {
+        return base_.elem==base_.space;
+    }
+
+    template <typename T, std::size_t N, typename A, typename G>
+    bool SmallVector<T,N,A,G>::is_inline() const {
+        return base_.elem==inline_begin();
+    }
+
+    template <typename T, std::size_t N, typename A, typename G>
+    void SmallVector<T,N,A,G>::destroy() {
+        for (T* p = base_.elem; p!= base_.space; ++p)
+            p->~T();
+        base_.space = base_.elem;
+    }
+
+    template <typename T, std::size_t N, typename A, typename G>
+    void SmallVector<T,N,A,G>::reserve(size_type n) {
+        if (n<=capacity()) return;
+
+        size_type sz = size();
+        VectorBase<T,A> tmp{base_.alloc, sz, n-sz};
+
+        // move elements
+        uninitialized_relocate(base_.elem, base_.space, tmp.elem);
+
+        base_.swap(tmp);
+        if (tmp.elem==inline_begin()) release_inline(tmp);
+    }
+
+    template <typename T, std::size_t N, typename A, typename G>
+    void SmallVector<T,N,A,G>::clear() {
+        destroy();
+    }
+
+    template <typename T, std::size_t N, typename A, typename G>
+    void SmallVector<T,N,A,G>::resize(size_type n) {
+        reserve(n);
+
+        size_type sz = size();
+
+        if (n <= sz) {
+            // destroy extra elements
+            for (T* p = base_.elem+n; p!=base_.elem+sz; ++p)
+                p->~T();
+        }
+        else {
+            // value-initialize extra elements
+            std::uninitialized_value_construct(base_.elem+sz, base_.elem+n);
+        }
+        base_.space = base_.elem+n;
+    }
+
+    template <typename T, std::size_t N, typename A, typename G>
+    void SmallVector<T,N,A,G>::resize(size_type n, const T& val) {
+        reserve(n);
+
+        size_type sz = size();
+
+        if (n <= sz) {
+            // destroy extra elements
+            for (T* p = base_.elem+n; p!=base_.elem+sz; ++p)
+                p->~T();
+        }
+        else {
+            // construct extra elements
+            std::uninitialized_fill(base_.elem+sz, base_.elem+n, val);
+        }
+        base_.space = base_.elem+n;
+    }
+
+    template <typename T, std::size_t N, typename A, typename G>
+    void SmallVector<T,N,A,G>::push_back(const T& val) {
+        emplace_back(val);
+    }
+
+    template <typename T, std::size_t N, typename A, typename G>
+    void SmallVector<T,N,A,G>::push_back(T&& val) {
+        emplace_back(std::move(val));
+    }
+
+    template <typename T, std::size_t N, typename A, typename G>
+    template <typename... Args>
+    T& SmallVector<T,N,A,G>::emplace_back(Args&&... args) {
+        if (size()==capacity()) {
+            // build the element aside first: args may refer to an element
+            // of this vector
+            T val(std::forward<Args>(args)...);
+            reserve(G::next_capacity(capacity(), size()+1));
+            new(static_cast<void*>(base_.space)) T(std::move(val));
+        }
+        else {
+            new(static_cast<void*>(base_.space)) T(std::forward<Args>(args)...);
+        }
+        ++base_.space;
+
+        return *(base_.space-1);
+    }
+
+    template <typename T, std::size_t N, typename A, typename G>
+    typename SmallVector<T,N,A,G>::iterator SmallVector<T,N,A,G>::begin() {
+        return base_.elem;
+    }
+
+    template <typename T, std::size_t N, typename A, typename G>
+    typename SmallVector<T,N,A,G>::const_iterator SmallVector<T,N,A,G>::begin() const {
+        return base_.elem;
+    }
+
+    template <typename T, std::size_t N, typename A, typename G>
+    typename SmallVector<T,N,A,G>::iterator SmallVector<T,N,A,G>::end() {
+        return base_.space;
+    }
+
+    template <typename T, std::size_t N, typename A, typename G>
+    typename SmallVector<T,N,A,G>::const_iterator SmallVector<T,N,A,G>::end() const {
+        return base_.space;
+    }
+
+    template <typename T, std::size_t N, typename A, typename G>
+    T* SmallVector<T,N,A,G>::inline_begin() {
+        return reinterpret_cast<T*>(inline_);
+    }
+
+    template <typename T, std::size_t N, typename A, typename G>
+    const T* SmallVector<T,N,A,G>::inline_begin() const {
+        return reinterpret_cast<const T*>(inline_);
+    }
+
+    template <typename T, std::size_t N, typename A, typename G>
+    void SmallVector<T,N,A,G>::release_inline(VectorBase<T,A>& b) {
+        b.elem = nullptr;
+        b.space = nullptr;
+        b.last = nullptr;
+    }
+
+    template <typename T, std::size_t N, typename A, typename G>
+    void SmallVector<T,N,A,G>::release_heap() {
+        if (is_inline()) return;
+
+        VectorBase<T,A> old{std::move(base_)};
+        base_.elem = base_.space = inline_begin();
+        base_.last = base_.elem+N;
+    }
+}
+
+#endif
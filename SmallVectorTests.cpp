@@ -0,0 +1,112 @@
+#include "catch.hpp"
+#include "SmallVector.hpp"
+#include <memory_resource>
+#include <string>
+
+using namespace tutorial;
+
+namespace {
+    // counts every allocation made on behalf of the vector
+    template <typename T>
+    struct CountingAllocator : std::allocator<T> {
+        template <typename U>
+        struct rebind { using other = CountingAllocator<U>; };
+
+        CountingAllocator() = default;
+
+        template <typename U>
+        CountingAllocator(const CountingAllocator<U>&) {}
+
+        T* allocate(std::size_t n) {
+            ++allocations;
+            return std::allocator<T>::allocate(n);
+        }
+
+        static int allocations;
+    };
+
+    template <typename T> int CountingAllocator<T>::allocations = 0;
+}
+
+TEST_CASE ("smallVectorStaysInline") {
+    CountingAllocator<int>::allocations = 0;
+    SmallVector<int, 16, CountingAllocator<int>> v;
+
+    for (int i=0; i!=16; ++i)
+        v.push_back(i);
+
+    REQUIRE(v.is_inline());
+    REQUIRE(v.size() == 16);
+    REQUIRE(CountingAllocator<int>::allocations == 0);
+
+    // spills to the heap past N
+    v.push_back(16);
+    REQUIRE_FALSE(v.is_inline());
+    REQUIRE(CountingAllocator<int>::allocations == 1);
+    REQUIRE(v.capacity() == 32);
+    REQUIRE(*(v.begin()+16) == 16);
+    REQUIRE(*(v.begin()+3) == 3);
+}
+
+TEST_CASE ("smallVectorCopyAndMove") {
+    SmallVector<std::string, 4> a = {"one", "two", "three"};
+    SmallVector<std::string, 4> b{a};
+
+    REQUIRE(b.size() == 3);
+    REQUIRE(*(b.begin()+2) == "three");
+
+    SmallVector<std::string, 4> c{std::move(a)};
+    REQUIRE(c.size() == 3);
+    REQUIRE(a.empty());
+
+    b.resize(10, "x");
+    REQUIRE_FALSE(b.is_inline());
+
+    c = std::move(b);
+    REQUIRE(c.size() == 10);
+    REQUIRE_FALSE(c.is_inline());
+    REQUIRE(b.empty());
+    REQUIRE(b.is_inline());
+
+    b = c;
+    REQUIRE(b.size() == 10);
+    REQUIRE(*(b.begin()+9) == "x");
+
+    b.resize(2);
+    REQUIRE(b.size() == 2);
+    REQUIRE(*(b.begin()+1) == "two");
+}
+
+TEST_CASE ("smallVectorPmrAllocators") {
+    using PmrSmallVector = SmallVector<std::string, 2, std::pmr::polymorphic_allocator<std::string>>;
+
+    std::pmr::unsynchronized_pool_resource pool;
+    PmrSmallVector a{&pool};
+    for (int i=0; i!=10; ++i)
+        a.push_back(std::to_string(i));
+    REQUIRE_FALSE(a.is_inline());
+
+    // copies don't inherit the resource
+    PmrSmallVector b{a};
+    REQUIRE(b.get_allocator().resource() == std::pmr::get_default_resource());
+    REQUIRE(*(b.begin()+9) == "9");
+
+    // a's buffer belongs to the pool, so it can't be adopted by b
+    b = std::move(a);
+    REQUIRE(b.get_allocator().resource() == std::pmr::get_default_resource());
+    REQUIRE(b.size() == 10);
+    REQUIRE(*(b.begin()+9) == "9");
+    REQUIRE(a.empty());
+    REQUIRE_FALSE(a.is_inline());
+
+    // same resource: the buffer is adopted
+    PmrSmallVector c{&pool};
+    c.push_back("x");
+    for (int i=0; i!=10; ++i)
+        a.push_back(std::to_string(i));
+    const std::string* buffer = a.begin();
+    c = std::move(a);
+    REQUIRE(c.begin() == buffer);
+    REQUIRE(c.size() == 10);
+    REQUIRE(a.is_inline());
+}
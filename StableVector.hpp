@@ -0,0 +1,343 @@
+#ifndef STABLE_VECTOR_HPP
+#define STABLE_VECTOR_HPP
+
+#include "Vector.hpp"
+#include <algorithm>
+#include <new>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace tutorial {
+
+    // vector whose elements never move. The first growth reserves
+    // ReserveBytes of address space with PROT_NONE, and growing only makes
+    // more of those pages accessible with mprotect: push_back never copies
+    // and pointers stay valid until the element is erased. The reservation
+    // costs address space, not memory; growing past it throws
+    // std::bad_alloc.
+    template <typename T, std::size_t ReserveBytes = std::size_t(1) << 32>
+    class StableVector {
+        static_assert(ReserveBytes >= sizeof(T), "StableVector reservation is too small");
+
+    public:
+        using size_type = std::size_t;
+        using iterator = T*;
+        using const_iterator = const T*;
+        using value_type = T;
+
+        StableVector() = default;
+        explicit StableVector(size_type n);
+        StableVector(size_type n, const T& val);
+        StableVector(std::initializer_list<value_type> data);
+
+        template <class InputIterator, typename = iterator_category_t<InputIterator>>
+        StableVector(InputIterator first, InputIterator last);
+
+        ~StableVector();
+
+        // copy operations
+        StableVector(const StableVector& rhs);
+        StableVector& operator=(const StableVector& rhs);
+
+        // move operations
+        StableVector(StableVector&& a);
+        StableVector& operator=(StableVector&& a);
+
+        void swap(StableVector& a);
+
+        size_type size() const;
+        size_type capacity() const;
+        static constexpr size_type max_size() { return ReserveBytes/sizeof(T); }
+
+        bool empty() const;
+        void destroy();
+
+        void reserve(size_type n);
+        void resize(size_type n);
+        void resize(size_type n, const T& val);
+        void clear();
+        void push_back(const T&);
+        void push_back(T&&);
+
+        template <typename... Args>
+        T& emplace_back(Args&&... args);
+
+        template <class InputIterator, typename = iterator_category_t<InputIterator>>
+        void append(InputIterator first, InputIterator last);
+
+        // inserting moves the elements after pos, as in Vector
+        template <class InputIterator, typename = iterator_category_t<InputIterator>>
+        iterator insert(const_iterator pos, InputIterator first, InputIterator last);
+        iterator insert(const_iterator pos, size_type n, const T& val);
+
+        T& operator[](size_type i);
+        const T& operator[](size_type i) const;
+
+        iterator begin();
+        const_iterator begin() const;
+
+        iterator end();
+        const_iterator end() const;
+
+    private:
+        static std::size_t page_size();
+
+        void release();
+
+        T* elem_ = nullptr;
+        size_type sz_ = 0;
+        size_type cap_ = 0;
+    };
+
+    template <typename T, std::size_t ReserveBytes>
+    StableVector<T,ReserveBytes>::StableVector(size_type n) {
+        resize(n);
+    }
+
+    template <typename T, std::size_t ReserveBytes>
+    StableVector<T,ReserveBytes>::StableVector(size_type n, const T& val) {
+        resize(n, val);
+    }
+
+    template <typename T, std::size_t ReserveBytes>
+    StableVector<T,ReserveBytes>::StableVector(std::initializer_list<value_type> data) {
+        append(data.begin(), data.end());
+    }
+
+    template <typename T, std::size_t ReserveBytes>
+    template <class InputIterator, typename>
+    StableVector<T,ReserveBytes>::StableVector(InputIterator first, InputIterator last) {
+        append(first, last);
+    }
+
+    template <typename T, std::size_t ReserveBytes>
+    StableVector<T,ReserveBytes>::~StableVector() {
+        release();
+    }
+
+    template <typename T, std::size_t ReserveBytes>
+    StableVector<T,ReserveBytes>::StableVector(const StableVector& rhs) {
+        append(rhs.begin(), rhs.end());
+    }
+
+    template <typename T, std::size_t ReserveBytes>
+    StableVector<T,ReserveBytes>& StableVector<T,ReserveBytes>::operator=(const StableVector& rhs) {
+        if (&rhs == this) return *this;
+
+        // reuse the committed pages
+        destroy();
+        append(rhs.begin(), rhs.end());
+
+        return *this;
+    }
+
+    template <typename T, std::size_t ReserveBytes>
+    StableVector<T,ReserveBytes>::StableVector(StableVector&& a):
+        elem_{a.elem_},
+        sz_{a.sz_},
+        cap_{a.cap_}
+    {
+        a.elem_ = nullptr;
+        a.sz_ = 0;
+        a.cap_ = 0;
+    }
+
+    template <typename T, std::size_t ReserveBytes>
+    StableVector<T,ReserveBytes>& StableVector<T,ReserveBytes>::operator=(StableVector&& a) {
+        swap(a);
+        return *this;
+    }
+
+    template <typename T, std::size_t ReserveBytes>
+    void StableVector<T,ReserveBytes>::swap(StableVector& a) {
+        std::swap(elem_, a.elem_);
+        std::swap(sz_, a.sz_);
+        std::swap(cap_, a.cap_);
+    }
+
+    template <typename T, std::size_t ReserveBytes>
+    typename StableVector<T,ReserveBytes>::size_type StableVector<T,ReserveBytes>::size() const {
+        return sz_;
+    }
+
+    template <typename T, std::size_t ReserveBytes>
+    typename StableVector<T,ReserveBytes>::size_type StableVector<T,ReserveBytes>::capacity() const {
+        return cap_;
+    }
+
+    template <typename T, std::size_t ReserveBytes>
+    bool StableVector<T,ReserveBytes>::empty() const {
+        return sz_==0;
+    }
+
+    template <typename T, std::size_t ReserveBytes>
+    void StableVector<T,ReserveBytes>::destroy() {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            for (T* p = elem_; p!=elem_+sz_; ++p)
+                p->~T();
+        }
+        sz_ = 0;
+    }
+
+    template <typename T, std::size_t ReserveBytes>
+    void StableVector<T,ReserveBytes>::reserve(size_type n) {
+        if (n <= cap_) return;
+        if (n > max_size()) throw std::bad_alloc{};
+
+        if (!elem_) {
+            void* p = mmap(nullptr, ReserveBytes, PROT_NONE,
+                           MAP_PRIVATE|MAP_ANONYMOUS|MAP_NORESERVE, -1, 0);
+            if (p==MAP_FAILED) throw std::bad_alloc{};
+            elem_ = static_cast<T*>(p);
+        }
+
+        // commit at least twice as much as before, so mprotect is called
+        // O(log n) times
+        std::size_t page = page_size();
+        std::size_t bytes = std::max(n, 2*cap_)*sizeof(T);
+        bytes = std::min((bytes+page-1) / page * page, ReserveBytes);
+
+        std::size_t committed = (cap_*sizeof(T)+page-1) / page * page;
+        char* base = reinterpret_cast<char*>(elem_);
+        if (mprotect(base+committed, bytes-committed, PROT_READ|PROT_WRITE))
+            throw std::bad_alloc{};
+
+        cap_ = bytes/sizeof(T);
+    }
+
+    template <typename T, std::size_t ReserveBytes>
+    void StableVector<T,ReserveBytes>::resize(size_type n) {
+        if (n <= sz_) {
+            // destroy extra elements
+            if constexpr (!std::is_trivially_destructible_v<T>) {
+                for (T* p = elem_+n; p!=elem_+sz_; ++p)
+                    p->~T();
+            }
+            sz_ = n;
+        }
+        else {
+            reserve(n);
+            while (sz_!=n)
+                emplace_back();
+        }
+    }
+
+    template <typename T, std::size_t ReserveBytes>
+    void StableVector<T,ReserveBytes>::resize(size_type n, const T& val) {
+        if (n <= sz_) {
+            resize(n);
+        }
+        else {
+            reserve(n);
+            while (sz_!=n)
+                emplace_back(val);
+        }
+    }
+
+    template <typename T, std::size_t ReserveBytes>
+    void StableVector<T,ReserveBytes>::clear() {
+        destroy();
+    }
+
+    template <typename T, std::size_t ReserveBytes>
+    void StableVector<T,ReserveBytes>::push_back(const T& val) {
+        emplace_back(val);
+    }
+
+    template <typename T, std::size_t ReserveBytes>
+    void StableVector<T,ReserveBytes>::push_back(T&& val) {
+        emplace_back(std::move(val));
+    }
+
+    template <typename T, std::size_t ReserveBytes>
+    template <typename... Args>
+    T& StableVector<T,ReserveBytes>::emplace_back(Args&&... args) {
+        // growing never moves the elements, so args may refer to one of them
+        if (sz_==cap_) reserve(sz_+1);
+
+        T* p = new(static_cast<void*>(elem_+sz_)) T(std::forward<Args>(args)...);
+        ++sz_;
+        return *p;
+    }
+
+    template <typename T, std::size_t ReserveBytes>
+    template <class InputIterator, typename>
+    void StableVector<T,ReserveBytes>::append(InputIterator first, InputIterator last) {
+        using Category = iterator_category_t<InputIterator>;
+
+        if constexpr (std::is_base_of_v<std::forward_iterator_tag, Category>)
+            reserve(sz_+std::distance(first, last));
+
+        for (; first!=last; ++first)
+            emplace_back(*first);
+    }
+
+    template <typename T, std::size_t ReserveBytes>
+    template <class InputIterator, typename>
+    typename StableVector<T,ReserveBytes>::iterator
+    StableVector<T,ReserveBytes>::insert(const_iterator pos, InputIterator first, InputIterator last) {
+        size_type off = pos-begin();
+        size_type old = sz_;
+
+        append(first, last);
+        std::rotate(begin()+off, begin()+old, end());
+        return begin()+off;
+    }
+
+    template <typename T, std::size_t ReserveBytes>
+    typename StableVector<T,ReserveBytes>::iterator
+    StableVector<T,ReserveBytes>::insert(const_iterator pos, size_type n, const T& val) {
+        size_type off = pos-begin();
+        size_type old = sz_;
+
+        resize(sz_+n, val);
+        std::rotate(begin()+off, begin()+old, end());
+        return begin()+off;
+    }
+
+    template <typename T, std::size_t ReserveBytes>
+    T& StableVector<T,ReserveBytes>::operator[](size_type i) {
+        return elem_[i];
+    }
+
+    template <typename T, std::size_t ReserveBytes>
+    const T& StableVector<T,ReserveBytes>::operator[](size_type i) const {
+        return elem_[i];
+    }
+
+    template <typename T, std::size_t ReserveBytes>
+    typename StableVector<T,ReserveBytes>::iterator StableVector<T,ReserveBytes>::begin() {
+        return elem_;
+    }
+
+    template <typename T, std::size_t ReserveBytes>
+    typename StableVector<T,ReserveBytes>::const_iterator StableVector<T,ReserveBytes>::begin() const {
+        return elem_;
+    }
+
+    template <typename T, std::size_t ReserveBytes>
+    typename StableVector<T,ReserveBytes>::iterator StableVector<T,ReserveBytes>::end() {
+        return elem_+sz_;
+    }
+
+    template <typename T, std::size_t ReserveBytes>
+    typename StableVector<T,ReserveBytes>::const_iterator StableVector<T,ReserveBytes>::end() const {
+        return elem_+sz_;
+    }
+
+    template <typename T, std::size_t ReserveBytes>
+    std::size_t StableVector<T,ReserveBytes>::page_size() {
+        static const std::size_t page = sysconf(_SC_PAGESIZE);
+        return page;
+    }
+
+    template <typename T, std::size_t ReserveBytes>
+    void StableVector<T,ReserveBytes>::release() {
+        destroy();
+        if (elem_) munmap(elem_, ReserveBytes);
+        elem_ = nullptr;
+        cap_ = 0;
+    }
+}
+
+#endif
@@ -0,0 +1,60 @@
+#include "catch.hpp"
+#include "StableVector.hpp"
+#include <string>
+
+using namespace tutorial;
+
+TEST_CASE ("stableVectorNeverMoves") {
+    StableVector<std::string> v;
+    v.push_back("first");
+
+    const std::string* first = &v[0];
+    const char* chars = v[0].data();
+
+    for (int i=0; i!=100000; ++i)
+        v.push_back(std::to_string(i));
+
+    REQUIRE(&v[0] == first);
+    REQUIRE(v[0].data() == chars);
+    REQUIRE(v.size() == 100001);
+    REQUIRE(v.capacity() >= v.size());
+    REQUIRE(v[100000] == "99999");
+
+    // growing from one of its own elements is fine, nothing moves
+    v.push_back(v[0]);
+    REQUIRE(v[100001] == "first");
+}
+
+TEST_CASE ("stableVectorOperations") {
+    StableVector<int> v{1, 2, 3};
+    v.insert(v.begin()+1, 2, 9);
+    REQUIRE(std::equal(v.begin(), v.end(), std::begin({1, 9, 9, 2, 3})));
+
+    int more[] = {7, 8};
+    v.insert(v.end(), std::begin(more), std::end(more));
+    REQUIRE(v.size() == 7);
+    REQUIRE(v[6] == 8);
+
+    StableVector<int> copy{v};
+    v.resize(2);
+    REQUIRE(copy.size() == 7);
+
+    StableVector<int> moved{std::move(copy)};
+    REQUIRE(copy.empty());
+    REQUIRE(moved[1] == 9);
+
+    copy = moved;
+    REQUIRE(copy.size() == 7);
+
+    v.resize(5, 4);
+    REQUIRE(v[4] == 4);
+}
+
+TEST_CASE ("stableVectorReservationLimit") {
+    StableVector<int, 1 << 16> v;
+    REQUIRE(v.max_size() == 16384);
+
+    v.resize(16384);
+    REQUIRE_THROWS_AS(v.push_back(0), std::bad_alloc);
+    REQUIRE(v.size() == 16384);
+}
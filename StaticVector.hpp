@@ -0,0 +1,308 @@
+#ifndef STATIC_VECTOR_HPP
+#define STATIC_VECTOR_HPP
+
+#include "Vector.hpp"
+#include <new>
+
+namespace tutorial {
+
+    // slots of the plain array that trivial types live in. Constant
+    // evaluation needs every slot initialized. From C++20 that is only done
+    // when constant-evaluated, so a StaticVector built at run time costs
+    // nothing for its unused slots. Before C++20 a constexpr constructor has
+    // to initialize the whole array, zeroing all N slots every time one is
+    // created, so only the Constexpr variant does.
+    template <typename T, std::size_t N, bool Constexpr>
+    struct StaticVectorSlots {
+#if __cpp_constexpr >= 201907L
+        constexpr StaticVectorSlots() {
+            if (__builtin_is_constant_evaluated()) {
+                for (T& x : elems)
+                    x = T();
+            }
+        }
+#endif
+
+        T elems[N];
+    };
+
+#if __cpp_constexpr < 201907L
+    template <typename T, std::size_t N>
+    struct StaticVectorSlots<T, N, true> {
+        T elems[N] {};
+    };
+#endif
+
+    // storage for StaticVector. Trivial types live in a plain array so that
+    // every operation can be constexpr; everything else is constructed in
+    // place in a raw aligned buffer.
+    template <typename T, std::size_t N, bool Constexpr, bool = std::is_trivial_v<T>>
+    struct StaticVectorStorage : StaticVectorSlots<T, N, Constexpr> {
+        constexpr T* data() { return this->elems; }
+        constexpr const T* data() const { return this->elems; }
+
+        template <typename... Args>
+        constexpr void construct(std::size_t i, Args&&... args) {
+            this->elems[i] = T(std::forward<Args>(args)...);
+        }
+
+        constexpr void destroy(std::size_t, std::size_t) {}
+
+        std::size_t sz = 0;
+    };
+
+    template <typename T, std::size_t N, bool Constexpr>
+    struct StaticVectorStorage<T, N, Constexpr, false> {
+        StaticVectorStorage() = default;
+
+        StaticVectorStorage(const StaticVectorStorage& a) {
+            std::uninitialized_copy(a.data(), a.data()+a.sz, data());
+            sz = a.sz;
+        }
+
+        StaticVectorStorage& operator=(const StaticVectorStorage& a) {
+            if (&a == this) return *this;
+
+            destroy(0, sz);
+            sz = 0;
+            std::uninitialized_copy(a.data(), a.data()+a.sz, data());
+            sz = a.sz;
+
+            return *this;
+        }
+
+        StaticVectorStorage(StaticVectorStorage&& a) {
+            uninitialized_relocate(a.data(), a.data()+a.sz, data());
+            sz = a.sz;
+            a.sz = 0;
+        }
+
+        StaticVectorStorage& operator=(StaticVectorStorage&& a) {
+            if (&a == this) return *this;
+
+            destroy(0, sz);
+            uninitialized_relocate(a.data(), a.data()+a.sz, data());
+            sz = a.sz;
+            a.sz = 0;
+
+            return *this;
+        }
+
+        ~StaticVectorStorage() {
+            destroy(0, sz);
+        }
+
+        T* data() { return reinterpret_cast<T*>(buf); }
+        const T* data() const { return reinterpret_cast<const T*>(buf); }
+
+        template <typename... Args>
+        void construct(std::size_t i, Args&&... args) {
+            new(static_cast<void*>(data()+i)) T(std::forward<Args>(args)...);
+        }
+
+        void destroy(std::size_t first, std::size_t last) {
+            for (T* p = data()+first; p!=data()+last; ++p)
+                p->~T();
+        }
+
+        alignas(T) unsigned char buf[N*sizeof(T)];
+        std::size_t sz = 0;
+    };
+
+    // fixed-capacity vector that never allocates: all N slots live inside
+    // the object. Growing past N throws std::bad_alloc from the plain
+    // operations; the try_ variants report failure by returning nullptr
+    // instead, for code that must not throw.
+    //
+    // With C++17, a StaticVector of trivial elements is only usable in
+    // constant expressions when Constexpr is set, at the cost of zeroing
+    // every slot on construction. From C++20 it always is, and Constexpr
+    // has no effect.
+    template <typename T, std::size_t N, bool Constexpr = false>
+    class StaticVector {
+        static_assert(N > 0, "StaticVector needs a capacity");
+
+    public:
+        using size_type = std::size_t;
+        using iterator = T*;
+        using const_iterator = const T*;
+        using value_type = T;
+
+        constexpr StaticVector() = default;
+        constexpr explicit StaticVector(size_type n);
+        constexpr StaticVector(size_type n, const T& val);
+        constexpr StaticVector(std::initializer_list<value_type> data);
+
+        constexpr size_type size() const;
+        static constexpr size_type capacity() { return N; }
+
+        constexpr bool empty() const;
+        constexpr bool full() const;
+        constexpr void destroy();
+
+        constexpr void reserve(size_type n);
+        constexpr void resize(size_type n);
+        constexpr void resize(size_type n, const T& val);
+        constexpr void clear();
+        constexpr void push_back(const T&);
+        constexpr void push_back(T&&);
+
+        template <typename... Args>
+        constexpr T& emplace_back(Args&&... args);
+
+        constexpr T* try_push_back(const T&);
+        constexpr T* try_push_back(T&&);
+
+        template <typename... Args>
+        constexpr T* try_emplace_back(Args&&... args);
+
+        constexpr iterator begin();
+        constexpr const_iterator begin() const;
+
+        constexpr iterator end();
+        constexpr const_iterator end() const;
+
+    private:
+        StaticVectorStorage<T, N, Constexpr> store_;
+    };
+
+    template <typename T, std::size_t N, bool C>
+    constexpr StaticVector<T,N,C>::StaticVector(size_type n) {
+        resize(n);
+    }
+
+    template <typename T, std::size_t N, bool C>
+    constexpr StaticVector<T,N,C>::StaticVector(size_type n, const T& val) {
+        resize(n, val);
+    }
+
+    template <typename T, std::size_t N, bool C>
+    constexpr StaticVector<T,N,C>::StaticVector(std::initializer_list<value_type> data) {
+        reserve(data.size());
+        for (const T& x : data)
+            store_.construct(store_.sz++, x);
+    }
+
+    template <typename T, std::size_t N, bool C>
+    constexpr typename StaticVector<T,N,C>::size_type StaticVector<T,N,C>::size() const {
+        return store_.sz;
+    }
+
+    template <typename T, std::size_t N, bool C>
+    constexpr bool StaticVector<T,N,C>::empty() const {
+        return store_.sz==0;
+    }
+
+    template <typename T, std::size_t N, bool C>
+    constexpr bool StaticVector<T,N,C>::full() const {
+        return store_.sz==N;
+    }
+
+    template <typename T, std::size_t N, bool C>
+    constexpr void StaticVector<T,N,C>::destroy() {
+        store_.destroy(0, store_.sz);
+        store_.sz = 0;
+    }
+
+    template <typename T, std::size_t N, bool C>
+    constexpr void StaticVector<T,N,C>::reserve(size_type n) {
+        if (n>N) throw std::bad_alloc{};
+    }
+
+    template <typename T, std::size_t N, bool C>
+    constexpr void StaticVector<T,N,C>::clear() {
+        destroy();
+    }
+
+    template <typename T, std::size_t N, bool C>
+    constexpr void StaticVector<T,N,C>::resize(size_type n) {
+        reserve(n);
+
+        if (n <= store_.sz) {
+            // destroy extra elements
+            store_.destroy(n, store_.sz);
+        }
+        else {
+            // value-initialize extra elements
+            for (size_type i = store_.sz; i!=n; ++i)
+                store_.construct(i);
+        }
+        store_.sz = n;
+    }
+
+    template <typename T, std::size_t N, bool C>
+    constexpr void StaticVector<T,N,C>::resize(size_type n, const T& val) {
+        reserve(n);
+
+        if (n <= store_.sz) {
+            // destroy extra elements
+            store_.destroy(n, store_.sz);
+        }
+        else {
+            // construct extra elements
+            for (size_type i = store_.sz; i!=n; ++i)
+                store_.construct(i, val);
+        }
+        store_.sz = n;
+    }
+
+    template <typename T, std::size_t N, bool C>
+    constexpr void StaticVector<T,N,C>::push_back(const T& val) {
+        emplace_back(val);
+    }
+
+    template <typename T, std::size_t N, bool C>
+    constexpr void StaticVector<T,N,C>::push_back(T&& val) {
+        emplace_back(std::move(val));
+    }
+
+    template <typename T, std::size_t N, bool C>
+    template <typename... Args>
+    constexpr T& StaticVector<T,N,C>::emplace_back(Args&&... args) {
+        T* p = try_emplace_back(std::forward<Args>(args)...);
+        if (!p) throw std::bad_alloc{};
+
+        return *p;
+    }
+
+    template <typename T, std::size_t N, bool C>
+    constexpr T* StaticVector<T,N,C>::try_push_back(const T& val) {
+        return try_emplace_back(val);
+    }
+
+    template <typename T, std::size_t N, bool C>
+    constexpr T* StaticVector<T,N,C>::try_push_back(T&& val) {
+        return try_emplace_back(std::move(val));
+    }
+
+    template <typename T, std::size_t N, bool C>
+    template <typename... Args>
+    constexpr T* StaticVector<T,N,C>::try_emplace_back(Args&&... args) {
+        if (full()) return nullptr;
+
+        store_.construct(store_.sz, std::forward<Args>(args)...);
+        return store_.data()+store_.sz++;
+    }
+
+    template <typename T, std::size_t N, bool C>
+    constexpr typename StaticVector<T,N,C>::iterator StaticVector<T,N,C>::begin() {
+        return store_.data();
+    }
+
+    template <typename T, std::size_t N, bool C>
+    constexpr typename StaticVector<T,N,C>::const_iterator StaticVector<T,N,C>::begin() const {
+        return store_.data();
+    }
+
+    template <typename T, std::size_t N, bool C>
+    constexpr typename StaticVector<T,N,C>::iterator StaticVector<T,N,C>::end() {
+        return store_.data()+store_.sz;
+    }
+
+    template <typename T, std::size_t N, bool C>
+    constexpr typename StaticVector<T,N,C>::const_iterator StaticVector<T,N,C>::end() const {
+        return store_.data()+store_.sz;
+    }
+}
+
+#endif
@@ -0,0 +1,57 @@
+#include "catch.hpp"
+#include "StaticVector.hpp"
+#include <string>
+
+using namespace tutorial;
+
+namespace {
+    constexpr StaticVector<int, 8, true> make_squares() {
+        StaticVector<int, 8, true> v;
+        for (int i=0; i!=5; ++i)
+            v.push_back(i*i);
+        return v;
+    }
+}
+
+TEST_CASE ("staticVectorIsConstexpr") {
+    constexpr auto v = make_squares();
+
+    static_assert(v.size() == 5, "");
+    static_assert(*(v.begin()+4) == 16, "");
+    static_assert(std::is_trivially_copyable<StaticVector<int, 8>>::value, "");
+
+    REQUIRE(v.size() == 5);
+}
+
+TEST_CASE ("staticVectorTryPushBack") {
+    StaticVector<int, 4> v;
+
+    for (int i=0; i!=4; ++i)
+        REQUIRE(v.try_push_back(i));
+
+    REQUIRE(v.full());
+    REQUIRE(v.try_push_back(4) == nullptr);
+    REQUIRE(v.size() == 4);
+    REQUIRE_THROWS_AS(v.push_back(4), std::bad_alloc);
+}
+
+TEST_CASE ("staticVectorNonTrivialElements") {
+    StaticVector<std::string, 4> a = {"one", "two"};
+    a.emplace_back(3, 'x');
+
+    StaticVector<std::string, 4> b{a};
+    REQUIRE(b.size() == 3);
+    REQUIRE(*(b.begin()+2) == "xxx");
+
+    StaticVector<std::string, 4> c{std::move(a)};
+    REQUIRE(c.size() == 3);
+    REQUIRE(a.empty());
+
+    c.resize(1);
+    REQUIRE(c.size() == 1);
+    REQUIRE(*c.begin() == "one");
+
+    a = b;
+    REQUIRE(a.size() == 3);
+    REQUIRE_THROWS_AS(a.resize(5), std::bad_alloc);
+}
@@ -0,0 +1,112 @@
+#ifndef STREAMING_STORES_HPP
+#define STREAMING_STORES_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#endif
+
+namespace tutorial {
+
+    // copies and fills of at least this many bytes use non-temporal stores,
+    // which write around the cache instead of evicting the working set.
+    // Only worth it for buffers much larger than the last level cache.
+    inline std::size_t streaming_store_threshold = std::size_t(32) << 20;
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+
+    __attribute__((target("avx2")))
+    inline void stream_copy_avx2(char* d, const char* s, std::size_t n) {
+        for (; n>=32; n-=32, d+=32, s+=32)
+            _mm256_stream_si256(reinterpret_cast<__m256i*>(d),
+                                _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s)));
+    }
+
+    __attribute__((target("avx2")))
+    inline void stream_fill_avx2(char* d, const char* pattern, std::size_t n) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pattern));
+        for (; n>=32; n-=32, d+=32)
+            _mm256_stream_si256(reinterpret_cast<__m256i*>(d), v);
+    }
+
+    inline void stream_copy_sse2(char* d, const char* s, std::size_t n) {
+        for (; n>=16; n-=16, d+=16, s+=16)
+            _mm_stream_si128(reinterpret_cast<__m128i*>(d),
+                             _mm_loadu_si128(reinterpret_cast<const __m128i*>(s)));
+    }
+
+    // n must be a multiple of 32: the pattern is stored as two halves
+    inline void stream_fill_sse2(char* d, const char* pattern, std::size_t n) {
+        __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pattern));
+        __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pattern+16));
+        for (; n>=32; n-=32, d+=32) {
+            _mm_stream_si128(reinterpret_cast<__m128i*>(d), lo);
+            _mm_stream_si128(reinterpret_cast<__m128i*>(d+16), hi);
+        }
+    }
+
+    inline bool has_avx2() {
+        static const bool avx2 = __builtin_cpu_supports("avx2");
+        return avx2;
+    }
+
+    // copies bytes from src to dst, writing dst with non-temporal stores
+    inline void stream_copy(void* dst, const void* src, std::size_t bytes) {
+        char* d = static_cast<char*>(dst);
+        const char* s = static_cast<const char*>(src);
+
+        // regular stores up to the first 32 byte boundary
+        std::size_t head = (32 - reinterpret_cast<std::uintptr_t>(d)%32) % 32;
+        if (head > bytes) head = bytes;
+        std::memcpy(d, s, head);
+        d += head;
+        s += head;
+        bytes -= head;
+
+        std::size_t body = bytes & ~std::size_t(31);
+        if (has_avx2()) stream_copy_avx2(d, s, body);
+        else stream_copy_sse2(d, s, body);
+        _mm_sfence();
+
+        std::memcpy(d+body, s+body, bytes-body);
+    }
+
+    // fills bytes at dst, which must be 32 byte aligned, by repeating a
+    // 32 byte pattern with non-temporal stores
+    inline void stream_fill(void* dst, const void* pattern, std::size_t bytes) {
+        char* d = static_cast<char*>(dst);
+        const char* p = static_cast<const char*>(pattern);
+
+        std::size_t body = bytes & ~std::size_t(31);
+        if (has_avx2()) stream_fill_avx2(d, p, body);
+        else stream_fill_sse2(d, p, body);
+        _mm_sfence();
+
+        std::memcpy(d+body, p, bytes-body);
+    }
+
+    constexpr bool has_streaming_stores = true;
+
+#else
+
+    inline void stream_copy(void* dst, const void* src, std::size_t bytes) {
+        std::memcpy(dst, src, bytes);
+    }
+
+    inline void stream_fill(void* dst, const void* pattern, std::size_t bytes) {
+        char* d = static_cast<char*>(dst);
+        for (; bytes>=32; bytes-=32, d+=32)
+            std::memcpy(d, pattern, 32);
+        std::memcpy(d, pattern, bytes);
+    }
+
+    constexpr bool has_streaming_stores = false;
+
+#endif
+
+}
+
+#endif
@@ -5,21 +5,202 @@
 #include <algorithm>
 #include <initializer_list>
 #include <iterator>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <memory_resource>
+
+#include "StreamingStores.hpp"
 
 namespace tutorial {
 
+    // growth policies compute the capacity to grow to when a vector runs
+    // out of space. Any type with a static next_capacity(cap, required)
+    // member can be used, so users can plug in their own strategy.
+    template <std::size_t Num, std::size_t Den>
+    struct GeometricGrowth {
+        static_assert(Den > 0 && Num > Den, "growth factor must be greater than 1");
+
+        template <typename S>
+        static S next_capacity(S cap, S required) {
+            // cap*Num/Den, written so that it doesn't overflow for large cap
+            S grown = cap + (cap/Den)*(Num-Den) + (cap%Den)*(Num-Den)/Den;
+
+            // always make progress, even for small capacities
+            grown = std::max(grown, S(cap+1));
+            return std::max(grown, required);
+        }
+    };
+
+    using DoublingGrowth = GeometricGrowth<2, 1>;
+    using OneAndHalfGrowth = GeometricGrowth<3, 2>;
+    using GoldenRatioGrowth = GeometricGrowth<1618, 1000>;
+
+    // a type is trivially relocatable if moving an object to a new address
+    // and destroying the original is equivalent to copying its bytes.
+    // Specialize this for types such as owning handles that are not
+    // trivially copyable but can still be relocated with memcpy.
+    template <typename T>
+    struct is_trivially_relocatable : std::is_trivially_copyable<T> {};
+
+    template <typename T>
+    constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
+    // moves [first,last) to uninitialized memory at dest and ends the
+    // lifetime of the source objects
+    template <typename T>
+    void uninitialized_relocate(T* first, T* last, T* dest) {
+        if constexpr (is_trivially_relocatable_v<T>) {
+            // the source is left as raw memory, no destructors to run
+            if (first!=last)
+                std::memcpy(static_cast<void*>(dest), static_cast<const void*>(first),
+                            (last-first)*sizeof(T));
+        }
+        else {
+            // move construct into dest and destroy the source
+            for (T* p = first; p!=last; ++p, ++dest) {
+                new (static_cast<void*>(dest)) T(std::move(*p));
+                p->~T();
+            }
+        }
+    }
+
+    // copies [first,last) to uninitialized memory at dest, as a single
+    // memcpy when the source is a contiguous range of trivially copyable T
+    // (with streaming stores for very large ranges)
+    template <typename InputIterator, typename T>
+    T* uninitialized_copy_fast(InputIterator first, InputIterator last, T* dest) {
+        using Source = std::remove_cv_t<std::remove_pointer_t<InputIterator>>;
+
+        if constexpr (std::is_pointer_v<InputIterator> && std::is_same_v<Source, T> &&
+                      std::is_trivially_copyable_v<T>) {
+            std::size_t bytes = (last-first)*sizeof(T);
+
+            if (has_streaming_stores && bytes >= streaming_store_threshold)
+                stream_copy(static_cast<void*>(dest), static_cast<const void*>(first), bytes);
+            else if (bytes)
+                std::memcpy(static_cast<void*>(dest), static_cast<const void*>(first), bytes);
+            return dest+(last-first);
+        }
+        else {
+            return std::uninitialized_copy(first, last, dest);
+        }
+    }
+
+    // a type is zero initializable if an all-zero object representation is
+    // the same as a value-initialized object. Specialize it for aggregates
+    // of such types to let them use zeroed allocations too.
+    template <typename T>
+    struct is_zero_initializable :
+        std::bool_constant<std::is_arithmetic_v<T> || std::is_enum_v<T> || std::is_pointer_v<T>> {};
+
+    template <typename T>
+    constexpr bool is_zero_initializable_v = is_zero_initializable<T>::value;
+
+    // fills [first,last) with copies of val, using streaming stores for very
+    // large ranges of trivially copyable T whose size divides 32
+    template <typename T>
+    void uninitialized_fill_fast(T* first, T* last, const T& val) {
+        if constexpr (std::is_trivially_copyable_v<T> && 32%sizeof(T)==0) {
+            if (has_streaming_stores && std::size_t(last-first)*sizeof(T) >= streaming_store_threshold) {
+                // regular stores until first is 32 byte aligned
+                for (std::size_t i = 0; i!=32/sizeof(T) && first!=last &&
+                                        reinterpret_cast<std::uintptr_t>(first)%32; ++i)
+                    std::memcpy(static_cast<void*>(first++), static_cast<const void*>(&val), sizeof(T));
+
+                if (reinterpret_cast<std::uintptr_t>(first)%32==0) {
+                    unsigned char pattern[32];
+                    for (std::size_t i = 0; i!=32; i += sizeof(T))
+                        std::memcpy(pattern+i, static_cast<const void*>(&val), sizeof(T));
+
+                    stream_fill(static_cast<void*>(first), pattern, (last-first)*sizeof(T));
+                    return;
+                }
+            }
+        }
+
+        std::uninitialized_fill(first, last, val);
+    }
+
+    // tag asking for default- instead of value-initialization, which leaves
+    // trivial elements such as arithmetic types uninitialized
+    struct default_init_t {
+        explicit default_init_t() = default;
+    };
+
+    inline constexpr default_init_t default_init{};
+
+    // SFINAE helper to tell iterators from other arguments
+    template <typename It>
+    using iterator_category_t = typename std::iterator_traits<It>::iterator_category;
+
+    // optional allocator extension: a.reallocate(p, old_n, new_n) resizes a
+    // block, moving its bytes if needed (e.g. with mremap)
+    template <typename A, typename = void>
+    struct has_reallocate : std::false_type {};
+
+    template <typename A>
+    struct has_reallocate<A, std::void_t<decltype(std::declval<A&>().reallocate(
+        std::declval<typename A::value_type*>(),
+        std::declval<typename std::allocator_traits<A>::size_type>(),
+        std::declval<typename std::allocator_traits<A>::size_type>()))>> : std::true_type {};
+
+    template <typename A>
+    constexpr bool has_reallocate_v = has_reallocate<A>::value;
+
+    // optional allocator extension: a.try_expand(p, old_n, new_n) grows a
+    // block without moving it and returns false if it can't
+    template <typename A, typename = void>
+    struct has_try_expand : std::false_type {};
+
+    template <typename A>
+    struct has_try_expand<A, std::void_t<decltype(bool(std::declval<A&>().try_expand(
+        std::declval<typename A::value_type*>(),
+        std::declval<typename std::allocator_traits<A>::size_type>(),
+        std::declval<typename std::allocator_traits<A>::size_type>())))>> : std::true_type {};
+
+    template <typename A>
+    constexpr bool has_try_expand_v = has_try_expand<A>::value;
+
+    // optional allocator extension: a.allocate_zeroed(n) returns zero-filled
+    // memory, e.g. from calloc or a fresh anonymous mapping, typically
+    // without writing to it
+    template <typename A, typename = void>
+    struct has_allocate_zeroed : std::false_type {};
+
+    template <typename A>
+    struct has_allocate_zeroed<A, std::void_t<decltype(std::declval<A&>().allocate_zeroed(
+        std::declval<typename std::allocator_traits<A>::size_type>()))>> : std::true_type {};
+
+    template <typename A>
+    constexpr bool has_allocate_zeroed_v = has_allocate_zeroed<A>::value;
+
     template <typename T, typename A = std::allocator<T>>
     struct VectorBase {
-        VectorBase(const A& a, typename A::size_type n, typename A::size_type m=0):
+        using traits = std::allocator_traits<A>;
+
+        struct zeroed_t {};
+
+        VectorBase(const A& a, typename traits::size_type n, typename traits::size_type m=0):
             alloc{a}
         {
-            elem = alloc.allocate(n+m);
+            elem = n+m ? alloc.allocate(n+m) : nullptr;
             space = elem+n;
             last = elem+n+m;
         }
 
+        // n elements of zero-filled memory, needs has_allocate_zeroed<A>
+        VectorBase(const A& a, typename traits::size_type n, zeroed_t):
+            alloc{a}
+        {
+            elem = n ? alloc.allocate_zeroed(n) : nullptr;
+            space = elem+n;
+            last = elem+n;
+        }
+
         ~VectorBase() {
-            alloc.deallocate(elem, last-elem);
+            if (elem) alloc.deallocate(elem, last-elem);
         }
 
         VectorBase(const VectorBase&) =delete;
@@ -36,8 +217,10 @@ namespace tutorial {
             a.last = nullptr;
         }
 
+        // takes over a's buffer, the caller must have released its own
         VectorBase& operator=(VectorBase&& a) {
-            alloc = a.alloc;
+            if constexpr (traits::propagate_on_container_move_assignment::value)
+                alloc = a.alloc;
             elem = a.elem;
             space = a.space;
             last = a.last;
@@ -48,6 +231,16 @@ namespace tutorial {
 
             return *this;
         }
+
+        // exchanges buffers; allocators are only exchanged if they propagate
+        // on swap, otherwise they must compare equal
+        void swap(VectorBase& a) {
+            if constexpr (traits::propagate_on_container_swap::value)
+                std::swap(alloc, a.alloc);
+            std::swap(elem, a.elem);
+            std::swap(space, a.space);
+            std::swap(last, a.last);
+        }
             
         A alloc;
         T* elem;
@@ -56,21 +249,30 @@ namespace tutorial {
     };
  
 
-    template <typename T, typename A = std::allocator<T>>
+    template <typename T, typename A = std::allocator<T>, typename G = DoublingGrowth>
     class Vector {
     public:
-        using size_type = typename A::size_type;
+        using size_type = typename std::allocator_traits<A>::size_type;
+        using allocator_type = A;
         using iterator = T*;
         using const_iterator = const T*;
         using value_type = T;
+        using growth_policy = G;
 
         explicit Vector(const A& = A());
-        explicit Vector(size_type n, const T& val = T(), const A& = A());
+        explicit Vector(size_type n, const A& = A());
+        Vector(size_type n, const T& val, const A& = A());
+        Vector(size_type n, default_init_t, const A& = A());
         Vector(std::initializer_list<value_type> data, const A& = A());
         
-        template <class InputIterator>
+        template <class InputIterator, typename = iterator_category_t<InputIterator>>
         Vector(InputIterator first, InputIterator last, const A& = A());
 
+        // hint is the expected number of elements, used to size the buffer
+        // up front when the range can only be traversed once
+        template <class InputIterator, typename = iterator_category_t<InputIterator>>
+        Vector(InputIterator first, InputIterator last, size_type hint, const A& = A());
+
         ~Vector();
 
         // copy operations
@@ -81,6 +283,9 @@ namespace tutorial {
         Vector(Vector&& a);
         Vector& operator=(Vector&& a);
 
+        void swap(Vector& a);
+        allocator_type get_allocator() const;
+
         size_type size() const;
         size_type capacity() const;
 
@@ -88,9 +293,26 @@ namespace tutorial {
         void destroy();
 
         void reserve(size_type n);
-        void resize(size_type n, const T& val = T());
+        void resize(size_type n);
+        void resize(size_type n, const T& val);
+        void resize_default_init(size_type n);
         void clear();
         void push_back(const T&);
+        void push_back(T&&);
+
+        template <typename... Args>
+        T& emplace_back(Args&&... args);
+
+        // bulk operations: each reallocates at most once
+        template <class InputIterator, typename = iterator_category_t<InputIterator>>
+        void append(InputIterator first, InputIterator last);
+
+        template <class InputIterator, typename = iterator_category_t<InputIterator>>
+        iterator insert(const_iterator pos, InputIterator first, InputIterator last);
+        iterator insert(const_iterator pos, size_type n, const T& val);
+
+        T& operator[](size_type i);
+        const T& operator[](size_type i) const;
 
         iterator begin();
         const_iterator begin() const;
@@ -99,54 +321,142 @@ namespace tutorial {
         const_iterator end() const;
 
     private:
+        template <typename... Args>
+        void grow_and_emplace(Args&&... args);
+
+        bool expand_in_place(size_type n);
+
+        // whether value-initialization can be done by allocating zeroed memory
+        static constexpr bool zero_allocate = is_zero_initializable_v<T> && has_allocate_zeroed_v<A>;
+
+        static VectorBase<T,A> value_initialized_base(const A& a, size_type n);
+
+        // inserts n elements at offset off, built by construct(dest) into
+        // raw memory
+        template <typename F>
+        iterator insert_with(size_type off, size_type n, F construct);
+
+        T* open_gap(size_type off, size_type n);
+        void close_gap(size_type off, size_type n);
+
+        bool contains(const T* p) const;
+
+        // elements that take an allocator, such as pmr strings, are built
+        // through allocator_traits::construct so that they use the vector's;
+        // everything else keeps the memcpy and streaming store paths
+        static constexpr bool allocator_constructs = std::uses_allocator_v<T, A>;
+
+        template <typename... Args>
+        static T* construct_at(A& a, T* p, Args&&... args);
+
+        template <typename InputIterator>
+        static T* construct_copy(A& a, InputIterator first, InputIterator last, T* dest);
+
+        static void construct_fill(A& a, T* first, T* last, const T& val);
+        static void construct_value(A& a, T* first, T* last);
+        static void construct_default(A& a, T* first, T* last);
+
+        // constructs each element of [first,last) from args through the
+        // allocator, destroying them again if one throws
+        template <typename... Args>
+        static void construct_each(A& a, T* first, T* last, const Args&... args);
+
         VectorBase<T,A> base_;
     };
 
-    template <typename T, typename A>
-    template <class InputIterator>
-    Vector<T,A>::Vector(InputIterator first, InputIterator last, const A& a) :
-        base_{a, std::distance(first, last)}
+    template <typename T, typename A, typename G>
+    template <class InputIterator, typename>
+    Vector<T,A,G>::Vector(InputIterator first, InputIterator last, const A& a) :
+        Vector(first, last, 0, a)
+    {}
+
+    template <typename T, typename A, typename G>
+    template <class InputIterator, typename>
+    Vector<T,A,G>::Vector(InputIterator first, InputIterator last, size_type hint, const A& a) :
+        base_{a, 0}
     {
-        std::uninitialized_copy(first, last, base_.elem);
+        using Category = iterator_category_t<InputIterator>;
+
+        if constexpr (std::is_base_of_v<std::forward_iterator_tag, Category>) {
+            // count once, then copy straight into a buffer of the right size
+            reserve(std::distance(first, last));
+            base_.space = construct_copy(base_.alloc, first, last, base_.elem);
+        }
+        else {
+            // a single pass: grow geometrically as elements arrive
+            reserve(hint);
+            try {
+                for (; first!=last; ++first)
+                    emplace_back(*first);
+            }
+            catch (...) {
+                destroy();
+                throw;
+            }
+        }
     }
 
-    template <typename T, typename A>
-    Vector<T,A>::Vector(std::initializer_list<value_type> data, const A& a) :
+    template <typename T, typename A, typename G>
+    Vector<T,A,G>::Vector(std::initializer_list<value_type> data, const A& a) :
         base_{a, data.size()}
     {
-        std::uninitialized_copy(data.begin(), data.end(), base_.elem);
+        construct_copy(base_.alloc, data.begin(), data.end(), base_.elem);
     }
 
-    template <typename T, typename A>
-    Vector<T,A>::Vector(const A& a):
+    template <typename T, typename A, typename G>
+    Vector<T,A,G>::Vector(const A& a):
         base_{a, 0}
     {}
 
-    template <typename T, typename A>
-    Vector<T,A>::Vector(size_type n, const T& val, const A& a):
+    template <typename T, typename A, typename G>
+    Vector<T,A,G>::Vector(size_type n, const A& a):
+        base_{value_initialized_base(a, n)}
+    {}
+
+    template <typename T, typename A, typename G>
+    Vector<T,A,G>::Vector(size_type n, default_init_t, const A& a):
+        base_{a, n}
+    {
+        // no-op for trivial types: the caller overwrites the elements
+        construct_default(base_.alloc, base_.elem, base_.elem+n);
+    }
+
+    template <typename T, typename A, typename G>
+    Vector<T,A,G>::Vector(size_type n, const T& val, const A& a):
         base_{a, n}
     {
         // constructs objects
-        std::uninitialized_fill(base_.elem, base_.elem+n, val);
+        construct_fill(base_.alloc, base_.elem, base_.elem+n, val);
     }
 
-    template <typename T, typename A>
-    Vector<T,A>::Vector(const Vector& rhs):
-        base_{rhs.base_.alloc, rhs.size()}
+    template <typename T, typename A, typename G>
+    Vector<T,A,G>::Vector(const Vector& rhs):
+        base_{std::allocator_traits<A>::select_on_container_copy_construction(rhs.base_.alloc), rhs.size()}
     {
        // now copy construct elements
-       std::uninitialized_copy(rhs.base_.elem, rhs.base_.elem+rhs.size(), base_.elem);
+       construct_copy(base_.alloc, rhs.base_.elem, rhs.base_.space, base_.elem);
     }
 
-    template <typename T, typename A>
-    Vector<T,A>& Vector<T,A>::operator=(const Vector& rhs) {
+    template <typename T, typename A, typename G>
+    Vector<T,A,G>& Vector<T,A,G>::operator=(const Vector& rhs) {
         if (&rhs == this) return *this;
 
+        if constexpr (std::allocator_traits<A>::propagate_on_container_copy_assignment::value) {
+            if (base_.alloc!=rhs.base_.alloc) {
+                // the storage belongs to the old allocator, release it first
+                destroy();
+                VectorBase<T,A> old{std::move(base_)};
+                base_.alloc = rhs.base_.alloc;
+            }
+        }
+
         if (capacity() < rhs.size()) {
-            Vector<T,A> tmp{rhs};
+            VectorBase<T,A> tmp{base_.alloc, rhs.size()};
+            construct_copy(base_.alloc, rhs.base_.elem, rhs.base_.space, tmp.elem);
         
             // now swap representations
-            swap(*this, tmp);
+            destroy();
+            base_.swap(tmp);
 
             return *this;
         }
@@ -154,7 +464,13 @@ namespace tutorial {
         size_type sz = size();
         size_type asz = rhs.size();
 
-        if (asz <= sz) {
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            // reuse the storage, nothing to destroy or construct
+            if (asz)
+                std::memcpy(static_cast<void*>(base_.elem), static_cast<const void*>(rhs.base_.elem),
+                            asz*sizeof(T));
+        }
+        else if (asz <= sz) {
             std::copy(rhs.begin(), rhs.begin()+asz, base_.elem);
 
             // delete extra elements
@@ -165,96 +481,201 @@ namespace tutorial {
             std::copy(rhs.begin(), rhs.begin()+sz, base_.elem);
 
             // construct extra elements
-            std::uninitialized_copy(rhs.begin()+sz, rhs.begin()+asz, base_.elem);
+            construct_copy(base_.alloc, rhs.begin()+sz, rhs.begin()+asz, base_.elem+sz);
         }
+        base_.space = base_.elem+asz;
 
         return *this;
     }
 
-    template <typename T, typename A>
-    Vector<T,A>::Vector(Vector&& a):
-        base_{a.base_}
+    template <typename T, typename A, typename G>
+    Vector<T,A,G>::Vector(Vector&& a):
+        base_{std::move(a.base_)}
     {}
 
-    template <typename T, typename A>
-    Vector<T,A>& Vector<T,A>::operator=(Vector&& a) {
+    template <typename T, typename A, typename G>
+    Vector<T,A,G>& Vector<T,A,G>::operator=(Vector&& a) {
+        using traits = std::allocator_traits<A>;
+
+        if constexpr (traits::propagate_on_container_move_assignment::value) {
+            std::swap(base_.alloc, a.base_.alloc);
+        }
+        else if constexpr (!traits::is_always_equal::value) {
+            if (base_.alloc!=a.base_.alloc) {
+                // a's buffer can't be adopted, move the elements instead
+                destroy();
+                reserve(a.size());
+                base_.space = construct_copy(base_.alloc, std::make_move_iterator(a.begin()),
+                                             std::make_move_iterator(a.end()), base_.elem);
+                a.destroy();
+
+                return *this;
+            }
+        }
+
         // swap representations
-        swap(base_, a.base_);
+        std::swap(base_.elem, a.base_.elem);
+        std::swap(base_.space, a.base_.space);
+        std::swap(base_.last, a.base_.last);
 
         return *this;
     }
 
-    template <typename T, typename A>
-    Vector<T,A>::~Vector() {
+    template <typename T, typename A, typename G>
+    void Vector<T,A,G>::swap(Vector& a) {
+        base_.swap(a.base_);
+    }
+
+    template <typename T, typename A, typename G>
+    void swap(Vector<T,A,G>& a, Vector<T,A,G>& b) {
+        a.swap(b);
+    }
+
+    template <typename T, typename A, typename G>
+    typename Vector<T,A,G>::allocator_type Vector<T,A,G>::get_allocator() const {
+        return base_.alloc;
+    }
+
+    template <typename T, typename A, typename G>
+    Vector<T,A,G>::~Vector() {
         destroy();
     }
 
-    template <typename T, typename A>
-    void Vector<T,A>::destroy() {
-        for (T* p = base_.elem; p!= base_.space; ++p)
-            p->~T();
+    template <typename T, typename A, typename G>
+    void Vector<T,A,G>::destroy() {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            for (T* p = base_.elem; p!= base_.space; ++p)
+                p->~T();
+        }
         base_.space = base_.elem;
     }
 
-    template <typename T, typename A>
-    bool Vector<T,A>::empty() const {
+    template <typename T, typename A, typename G>
+    bool Vector<T,A,G>::empty() const {
         return base_.elem==base_.space;
     }
 
-    template <typename T, typename A>
-    typename Vector<T,A>::size_type Vector<T,A>::size() const {
+    template <typename T, typename A, typename G>
+    typename Vector<T,A,G>::size_type Vector<T,A,G>::size() const {
         return base_.space-base_.elem;
     }
 
-    template <typename T, typename A>
-    typename Vector<T,A>::size_type Vector<T,A>::capacity() const {
+    template <typename T, typename A, typename G>
+    typename Vector<T,A,G>::size_type Vector<T,A,G>::capacity() const {
         return base_.last-base_.elem;
     }
 
-    template <typename T, typename A>
-    typename Vector<T,A>::iterator Vector<T,A>::begin() {
+    template <typename T, typename A, typename G>
+    T& Vector<T,A,G>::operator[](size_type i) {
+        return base_.elem[i];
+    }
+
+    template <typename T, typename A, typename G>
+    const T& Vector<T,A,G>::operator[](size_type i) const {
+        return base_.elem[i];
+    }
+
+    template <typename T, typename A, typename G>
+    typename Vector<T,A,G>::iterator Vector<T,A,G>::begin() {
         return base_.elem;
     }
 
-    template <typename T, typename A>
-    typename Vector<T,A>::const_iterator Vector<T,A>::begin() const {
+    template <typename T, typename A, typename G>
+    typename Vector<T,A,G>::const_iterator Vector<T,A,G>::begin() const {
         return base_.elem;
     }
 
-    template <typename T, typename A>
-    typename Vector<T,A>::iterator Vector<T,A>::end() {
+    template <typename T, typename A, typename G>
+    typename Vector<T,A,G>::iterator Vector<T,A,G>::end() {
         return base_.space;
     }
     
-    template <typename T, typename A>
-    typename Vector<T,A>::const_iterator Vector<T,A>::end() const {
+    template <typename T, typename A, typename G>
+    typename Vector<T,A,G>::const_iterator Vector<T,A,G>::end() const {
         return base_.space;
     }
     
-    template <typename T, typename A>
-    void Vector<T,A>::reserve(size_type n) {
+    template <typename T, typename A, typename G>
+    void Vector<T,A,G>::reserve(size_type n) {
         if (n<=capacity()) return;
+        if (expand_in_place(n)) return;
 
         size_type sz = size();
+
+        if constexpr (is_trivially_relocatable_v<T> && has_reallocate_v<A>) {
+            // let the allocator move the block
+            T* p = base_.alloc.reallocate(base_.elem, capacity(), n);
+            base_.elem = p;
+            base_.space = p+sz;
+            base_.last = p+n;
+            return;
+        }
+
         VectorBase<T,A> tmp{base_.alloc, sz, n-sz};
         
         // move elements
-        T* q = base_.elem;
-        for (T* p = base_.elem; p!=base_.elem+sz; ++p, ++q) {
-            new (static_cast<void*>(&*q)) T{std::move(*p)};
-            p->~T();
+        uninitialized_relocate(base_.elem, base_.space, tmp.elem);
+
+        base_.swap(tmp);
+    }
+
+    template <typename T, typename A, typename G>
+    bool Vector<T,A,G>::expand_in_place(size_type n) {
+        if constexpr (has_try_expand_v<A>) {
+            if (base_.elem && base_.alloc.try_expand(base_.elem, capacity(), n)) {
+                base_.last = base_.elem+n;
+                return true;
+            }
         }
 
-        swap(base_, tmp);
+        return false;
     }
- 
-    template <typename T, typename A>
-    void Vector<T,A>::clear() {
+
+    template <typename T, typename A, typename G>
+    void Vector<T,A,G>::clear() {
         resize(0);
     }
 
-    template <typename T, typename A>
-    void Vector<T,A>::resize(size_type n, const T& val) {
+    template <typename T, typename A, typename G>
+    void Vector<T,A,G>::resize(size_type n) {
+        if (empty() && n > capacity()) {
+            // a fresh buffer, which may come zeroed from the allocator
+            VectorBase<T,A> tmp{value_initialized_base(base_.alloc, n)};
+            base_.swap(tmp);
+            return;
+        }
+
+        reserve(n);
+
+        size_type sz = size();
+
+        if (n <= sz) {
+            // destroy extra elements
+            for (T* p = base_.elem+n; p!=base_.elem+sz; ++p)
+                p->~T();
+        }
+        else {
+            // value-initialize extra elements
+            construct_value(base_.alloc, base_.elem+sz, base_.elem+n);
+        }
+        base_.space = base_.elem+n;
+    }
+
+    template <typename T, typename A, typename G>
+    VectorBase<T,A> Vector<T,A,G>::value_initialized_base(const A& a, size_type n) {
+        if constexpr (zero_allocate) {
+            // the allocator hands out zeros, nothing to write
+            return VectorBase<T,A>{a, n, typename VectorBase<T,A>::zeroed_t{}};
+        }
+        else {
+            VectorBase<T,A> b{a, n};
+            construct_value(b.alloc, b.elem, b.elem+n);
+            return b;
+        }
+    }
+
+    template <typename T, typename A, typename G>
+    void Vector<T,A,G>::resize(size_type n, const T& val) {
         reserve(n);
 
         size_type sz = size();
@@ -266,20 +687,310 @@ namespace tutorial {
         }
         else {
             // construct extra elements
-            std::uninitialized_fill(base_.elem+sz, base_.elem+n, val);
+            construct_fill(base_.alloc, base_.elem+sz, base_.elem+n, val);
+        }
+        base_.space = base_.elem+n;
+    }
+
+    template <typename T, typename A, typename G>
+    void Vector<T,A,G>::resize_default_init(size_type n) {
+        reserve(n);
+
+        size_type sz = size();
+
+        if (n <= sz) {
+            // destroy extra elements
+            for (T* p = base_.elem+n; p!=base_.elem+sz; ++p)
+                p->~T();
+        }
+        else {
+            // default-initialize extra elements, leaving trivial ones as is
+            construct_default(base_.alloc, base_.elem+sz, base_.elem+n);
         }
         base_.space = base_.elem+n;
     }
 
-    template <typename T, typename A>
-    void Vector<T,A>::push_back(const T& val) {
+    template <typename T, typename A, typename G>
+    void Vector<T,A,G>::push_back(const T& val) {
+        emplace_back(val);
+    }
+
+    template <typename T, typename A, typename G>
+    void Vector<T,A,G>::push_back(T&& val) {
+        emplace_back(std::move(val));
+    }
+
+    template <typename T, typename A, typename G>
+    template <typename... Args>
+    T& Vector<T,A,G>::emplace_back(Args&&... args) {
         if (size()==capacity()) {
             // grow vector
-            reserve(std::min(size_type(8), size()*2));
+            grow_and_emplace(std::forward<Args>(args)...);
+        }
+        else {
+            construct_at(base_.alloc, base_.space, std::forward<Args>(args)...);
+            ++base_.space;
         }
 
-        new(static_cast<void*>(&*base_.space)) T{val};
-        ++base_.space;
+        return *(base_.space-1);
+    }
+
+    template <typename T, typename A, typename G>
+    template <typename... Args>
+    void Vector<T,A,G>::grow_and_emplace(Args&&... args) {
+        size_type sz = size();
+        size_type n = G::next_capacity(capacity(), sz+1);
+
+        if (expand_in_place(n)) {
+            // nothing moved, construct the element as usual
+            construct_at(base_.alloc, base_.space, std::forward<Args>(args)...);
+            ++base_.space;
+            return;
+        }
+
+        if constexpr (is_trivially_relocatable_v<T> && has_reallocate_v<A>) {
+            // the block is resized in place, so build the element aside first
+            alignas(T) unsigned char buf[sizeof(T)];
+            T* val = construct_at(base_.alloc, reinterpret_cast<T*>(buf), std::forward<Args>(args)...);
+            try {
+                reserve(n);
+            }
+            catch (...) {
+                val->~T();
+                throw;
+            }
+            uninitialized_relocate(val, val+1, base_.space);
+            ++base_.space;
+            return;
+        }
+
+        VectorBase<T,A> tmp{base_.alloc, sz, n-sz};
+
+        // construct the new element first: args may refer to an element
+        // of this vector
+        construct_at(base_.alloc, tmp.space, std::forward<Args>(args)...);
+        ++tmp.space;
+
+        uninitialized_relocate(base_.elem, base_.space, tmp.elem);
+        base_.space = base_.elem;
+
+        base_.swap(tmp);
+    }
+
+    template <typename T, typename A, typename G>
+    template <class InputIterator, typename>
+    void Vector<T,A,G>::append(InputIterator first, InputIterator last) {
+        insert(end(), first, last);
+    }
+
+    template <typename T, typename A, typename G>
+    template <class InputIterator, typename>
+    typename Vector<T,A,G>::iterator Vector<T,A,G>::insert(const_iterator pos,
+                                                           InputIterator first, InputIterator last) {
+        using Category = iterator_category_t<InputIterator>;
+        size_type off = pos-begin();
+
+        if constexpr (!std::is_base_of_v<std::forward_iterator_tag, Category>) {
+            // single pass only: collect the elements first
+            if (pos==end()) {
+                for (; first!=last; ++first)
+                    emplace_back(*first);
+                return begin()+off;
+            }
+
+            Vector tmp{base_.alloc};
+            for (; first!=last; ++first)
+                tmp.emplace_back(*first);
+
+            return insert(pos, std::make_move_iterator(tmp.begin()), std::make_move_iterator(tmp.end()));
+        }
+        else {
+            if constexpr (std::is_same_v<std::remove_cv_t<std::remove_pointer_t<InputIterator>>, T>) {
+                // the source is part of this vector and would be moved away
+                if (first!=last && contains(&*first)) {
+                    Vector tmp(first, last, base_.alloc);
+                    return insert(pos, tmp.begin(), tmp.end());
+                }
+            }
+
+            size_type n = std::distance(first, last);
+            return insert_with(off, n, [&](T* dest) {
+                construct_copy(base_.alloc, first, last, dest);
+            });
+        }
+    }
+
+    template <typename T, typename A, typename G>
+    typename Vector<T,A,G>::iterator Vector<T,A,G>::insert(const_iterator pos, size_type n, const T& val) {
+        if (contains(&val)) {
+            // val would be moved away when the gap opens
+            T copy(val);
+            return insert(pos, n, copy);
+        }
+
+        return insert_with(pos-begin(), n, [&](T* dest) {
+            construct_fill(base_.alloc, dest, dest+n, val);
+        });
+    }
+
+    template <typename T, typename A, typename G>
+    template <typename F>
+    typename Vector<T,A,G>::iterator Vector<T,A,G>::insert_with(size_type off, size_type n, F construct) {
+        size_type sz = size();
+
+        if (n==0) return begin()+off;
+
+        if (sz+n > capacity()) {
+            size_type cap = G::next_capacity(capacity(), sz+n);
+
+            if constexpr (is_trivially_relocatable_v<T> && has_reallocate_v<A>) {
+                reserve(cap);
+            }
+            else if (!expand_in_place(cap)) {
+                VectorBase<T,A> tmp{base_.alloc, sz+n, cap-sz-n};
+
+                // the source may still refer to the old buffer, so build the
+                // new elements before moving the old ones around them
+                construct(tmp.elem+off);
+                uninitialized_relocate(base_.elem, base_.elem+off, tmp.elem);
+                uninitialized_relocate(base_.elem+off, base_.space, tmp.elem+off+n);
+                base_.space = base_.elem;
+
+                base_.swap(tmp);
+                return begin()+off;
+            }
+        }
+
+        T* gap = open_gap(off, n);
+        try {
+            construct(gap);
+        }
+        catch (...) {
+            close_gap(off, n);
+            throw;
+        }
+
+        return gap;
+    }
+
+    template <typename T, typename A, typename G>
+    T* Vector<T,A,G>::open_gap(size_type off, size_type n) {
+        T* pos = base_.elem+off;
+
+        if constexpr (is_trivially_relocatable_v<T>) {
+            std::memmove(static_cast<void*>(pos+n), static_cast<const void*>(pos),
+                         (base_.space-pos)*sizeof(T));
+        }
+        else {
+            // relocate the tail back to front, the ranges overlap
+            for (T* p = base_.space; p!=pos; ) {
+                --p;
+                new (static_cast<void*>(p+n)) T(std::move(*p));
+                p->~T();
+            }
+        }
+        base_.space += n;
+
+        return pos;
+    }
+
+    template <typename T, typename A, typename G>
+    void Vector<T,A,G>::close_gap(size_type off, size_type n) {
+        T* pos = base_.elem+off;
+
+        if constexpr (is_trivially_relocatable_v<T>) {
+            std::memmove(static_cast<void*>(pos), static_cast<const void*>(pos+n),
+                         (base_.space-pos-n)*sizeof(T));
+        }
+        else {
+            for (T* p = pos+n; p!=base_.space; ++p) {
+                new (static_cast<void*>(p-n)) T(std::move(*p));
+                p->~T();
+            }
+        }
+        base_.space -= n;
+    }
+
+    template <typename T, typename A, typename G>
+    bool Vector<T,A,G>::contains(const T* p) const {
+        return base_.elem<=p && p<base_.space;
+    }
+
+    template <typename T, typename A, typename G>
+    template <typename... Args>
+    T* Vector<T,A,G>::construct_at(A& a, T* p, Args&&... args) {
+        if constexpr (allocator_constructs)
+            std::allocator_traits<A>::construct(a, p, std::forward<Args>(args)...);
+        else
+            new(static_cast<void*>(p)) T(std::forward<Args>(args)...);
+        return p;
+    }
+
+    template <typename T, typename A, typename G>
+    template <typename InputIterator>
+    T* Vector<T,A,G>::construct_copy(A& a, InputIterator first, InputIterator last, T* dest) {
+        if constexpr (allocator_constructs) {
+            T* p = dest;
+            try {
+                for (; first!=last; ++first, ++p)
+                    std::allocator_traits<A>::construct(a, p, *first);
+            }
+            catch (...) {
+                std::destroy(dest, p);
+                throw;
+            }
+            return p;
+        }
+        else {
+            return uninitialized_copy_fast(first, last, dest);
+        }
+    }
+
+    template <typename T, typename A, typename G>
+    void Vector<T,A,G>::construct_fill(A& a, T* first, T* last, const T& val) {
+        if constexpr (allocator_constructs)
+            construct_each(a, first, last, val);
+        else
+            uninitialized_fill_fast(first, last, val);
+    }
+
+    template <typename T, typename A, typename G>
+    void Vector<T,A,G>::construct_value(A& a, T* first, T* last) {
+        if constexpr (allocator_constructs)
+            construct_each(a, first, last);
+        else
+            std::uninitialized_value_construct(first, last);
+    }
+
+    template <typename T, typename A, typename G>
+    void Vector<T,A,G>::construct_default(A& a, T* first, T* last) {
+        // types that take an allocator are never trivial, so default- and
+        // value-initialization are the same for them
+        if constexpr (allocator_constructs)
+            construct_each(a, first, last);
+        else
+            std::uninitialized_default_construct(first, last);
+    }
+
+    template <typename T, typename A, typename G>
+    template <typename... Args>
+    void Vector<T,A,G>::construct_each(A& a, T* first, T* last, const Args&... args) {
+        T* p = first;
+        try {
+            for (; p!=last; ++p)
+                std::allocator_traits<A>::construct(a, p, args...);
+        }
+        catch (...) {
+            std::destroy(first, p);
+            throw;
+        }
+    }
+
+    namespace pmr {
+        // Vector whose allocation strategy is picked at run time through a
+        // std::pmr::memory_resource
+        template <typename T, typename G = DoublingGrowth>
+        using Vector = tutorial::Vector<T, std::pmr::polymorphic_allocator<T>, G>;
     }
 }
 
@@ -0,0 +1,172 @@
+#ifndef VECTOR_FILE_HPP
+#define VECTOR_FILE_HPP
+
+#include "Vector.hpp"
+#include "Crc32c.hpp"
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <system_error>
+#include <type_traits>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace tutorial {
+
+    // on-disk layout of a vector of trivially copyable T: this header,
+    // padding up to data_offset, then count elements of elem_size bytes
+    struct VectorFileHeader {
+        static constexpr char file_magic[8] = {'T', 'V', 'E', 'C', 'T', 'O', 'R', '1'};
+        static constexpr std::uint32_t native_endian = 0x01020304;
+        static constexpr std::uint64_t default_offset = 64;
+
+        char magic[8];
+        std::uint32_t endian;       // native_endian as written by the producer
+        std::uint32_t elem_size;
+        std::uint64_t count;
+        std::uint64_t data_offset;  // from the start of the file
+        std::uint32_t flags;
+        std::uint32_t checksum;     // CRC-32C of the data, if has_checksum
+        std::uint64_t reserved[3];
+
+        static constexpr std::uint32_t has_checksum = 1;
+    };
+
+    static_assert(sizeof(VectorFileHeader) <= VectorFileHeader::default_offset, "");
+
+    template <typename T>
+    VectorFileHeader make_vector_file_header(std::uint64_t count) {
+        static_assert(std::is_trivially_copyable_v<T>, "only trivially copyable types can be stored");
+
+        VectorFileHeader h{};
+        std::memcpy(h.magic, VectorFileHeader::file_magic, sizeof(h.magic));
+        h.endian = VectorFileHeader::native_endian;
+        h.elem_size = sizeof(T);
+        h.count = count;
+        h.data_offset = VectorFileHeader::default_offset;
+
+        return h;
+    }
+
+    // throws std::runtime_error unless h describes a file of file_size
+    // bytes holding T elements that can be used in place
+    template <typename T>
+    void validate_vector_file_header(const VectorFileHeader& h, std::uint64_t file_size) {
+        static_assert(std::is_trivially_copyable_v<T>, "only trivially copyable types can be loaded");
+
+        if (std::memcmp(h.magic, VectorFileHeader::file_magic, sizeof(h.magic)))
+            throw std::runtime_error{"not a vector file"};
+        if (h.endian!=VectorFileHeader::native_endian)
+            throw std::runtime_error{"vector file has the wrong byte order"};
+        if (h.elem_size!=sizeof(T))
+            throw std::runtime_error{"vector file has the wrong element size"};
+        if (h.data_offset < sizeof(VectorFileHeader) || h.data_offset%alignof(T))
+            throw std::runtime_error{"vector file data is misaligned"};
+        if (h.data_offset > file_size || h.count > (file_size-h.data_offset)/sizeof(T))
+            throw std::runtime_error{"vector file is truncated"};
+    }
+
+    // writes v to fd in the VectorFileHeader format, with a checksum: the
+    // header and the elements go out in a single writev
+    template <typename T, typename A, typename G>
+    void save(int fd, const Vector<T,A,G>& v) {
+        VectorFileHeader h = make_vector_file_header<T>(v.size());
+        h.flags = VectorFileHeader::has_checksum;
+        h.checksum = crc32c(v.begin(), v.size()*sizeof(T));
+
+        char header[VectorFileHeader::default_offset] = {};
+        std::memcpy(header, &h, sizeof(h));
+
+        iovec iov[2] = {
+            {header, sizeof(header)},
+            {const_cast<T*>(v.begin()), v.size()*sizeof(T)}
+        };
+
+        // writev may stop short, e.g. on pipes and sockets
+        iovec* p = iov;
+        int left = v.empty() ? 1 : 2;
+        while (left) {
+            ssize_t n = writev(fd, p, left);
+            if (n<0) {
+                if (errno==EINTR) continue;
+                throw std::system_error{errno, std::generic_category(), "writev"};
+            }
+
+            for (std::size_t done = n; left && done >= p->iov_len; ++p, --left)
+                done -= p->iov_len, n -= p->iov_len;
+            if (left) {
+                p->iov_base = static_cast<char*>(p->iov_base)+n;
+                p->iov_len -= n;
+            }
+        }
+    }
+
+    // reads exactly n bytes, returns false if the stream ends first
+    inline bool read_fully(int fd, void* buf, std::size_t n) {
+        char* p = static_cast<char*>(buf);
+
+        while (n) {
+            ssize_t r = read(fd, p, n);
+            if (r<0) {
+                if (errno==EINTR) continue;
+                throw std::system_error{errno, std::generic_category(), "read"};
+            }
+            if (r==0) return false;
+
+            p += r;
+            n -= r;
+        }
+
+        return true;
+    }
+
+    // replaces the contents of v with a vector read from fd, reading the
+    // elements straight into v's buffer
+    template <typename T, typename A, typename G>
+    void load(int fd, Vector<T,A,G>& v) {
+        struct stat st;
+        if (fstat(fd, &st)<0)
+            throw std::system_error{errno, std::generic_category(), "fstat"};
+
+        // the size of a regular file bounds count before anything is
+        // allocated; a pipe's size is only checked by reading
+        std::uint64_t file_size = UINT64_MAX;
+        if (S_ISREG(st.st_mode)) {
+            off_t pos = lseek(fd, 0, SEEK_CUR);
+            if (pos>=0 && pos<=st.st_size) file_size = st.st_size-pos;
+        }
+
+        VectorFileHeader h;
+        if (!read_fully(fd, &h, sizeof(h)))
+            throw std::runtime_error{"vector file is truncated"};
+
+        validate_vector_file_header<T>(h, file_size);
+
+        for (std::uint64_t skip = h.data_offset-sizeof(h); skip; ) {
+            char pad[64];
+            std::size_t n = skip < sizeof(pad) ? skip : sizeof(pad);
+            if (!read_fully(fd, pad, n))
+                throw std::runtime_error{"vector file is truncated"};
+            skip -= n;
+        }
+
+        // the old elements would only be relocated to be overwritten
+        v.clear();
+        v.resize_default_init(h.count);
+        if (!read_fully(fd, v.begin(), h.count*sizeof(T))) {
+            v.clear();
+            throw std::runtime_error{"vector file is truncated"};
+        }
+
+        if ((h.flags & VectorFileHeader::has_checksum) &&
+            crc32c(v.begin(), h.count*sizeof(T))!=h.checksum) {
+            v.clear();
+            throw std::runtime_error{"vector file checksum mismatch"};
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,102 @@
+#include "catch.hpp"
+#include "VectorFile.hpp"
+#include "MappedVector.hpp"
+#include <cstddef>
+#include <cstdio>
+#include <fcntl.h>
+
+using namespace tutorial;
+
+namespace {
+    // temporary file removed when done
+    struct TempFile {
+        TempFile() {
+            char name[] = "/tmp/vector_file_XXXXXX";
+            fd = mkstemp(name);
+            path = name;
+        }
+
+        ~TempFile() {
+            close(fd);
+            std::remove(path.c_str());
+        }
+
+        int fd;
+        std::string path;
+    };
+}
+
+TEST_CASE ("vectorFileRoundTrip") {
+    Vector<double> v;
+    for (int i=0; i!=100000; ++i)
+        v.push_back(i*0.5);
+
+    TempFile file;
+    save(file.fd, v);
+
+    lseek(file.fd, 0, SEEK_SET);
+    Vector<double> w{1.0, 2.0};
+    load(file.fd, w);
+    REQUIRE(w.size() == 100000);
+    REQUIRE(std::equal(w.begin(), w.end(), v.begin()));
+
+    // the same file can be mapped in place
+    MappedVector<double> m{file.path};
+    REQUIRE(m.size() == 100000);
+    REQUIRE(m[99999] == 49999.5);
+
+    Vector<double> empty;
+    TempFile other;
+    save(other.fd, empty);
+    lseek(other.fd, 0, SEEK_SET);
+    load(other.fd, w);
+    REQUIRE(w.empty());
+}
+
+TEST_CASE ("vectorFileThroughPipe") {
+    Vector<int> v(1000, 7);
+
+    int fds[2];
+    REQUIRE(pipe(fds) == 0);
+    save(fds[1], v);
+    close(fds[1]);
+
+    Vector<int> w;
+    load(fds[0], w);
+    close(fds[0]);
+    REQUIRE(w.size() == 1000);
+    REQUIRE(w[999] == 7);
+}
+
+TEST_CASE ("vectorFileDetectsCorruption") {
+    Vector<int> v(1000, 7);
+
+    TempFile file;
+    save(file.fd, v);
+
+    int bad = 8;
+    REQUIRE(pwrite(file.fd, &bad, sizeof(bad), VectorFileHeader::default_offset+500*sizeof(int)) == sizeof(bad));
+
+    lseek(file.fd, 0, SEEK_SET);
+    Vector<int> w;
+    REQUIRE_THROWS_AS(load(file.fd, w), std::runtime_error);
+    REQUIRE(w.empty());
+
+    REQUIRE(ftruncate(file.fd, VectorFileHeader::default_offset+10) == 0);
+    lseek(file.fd, 0, SEEK_SET);
+    REQUIRE_THROWS_AS(load(file.fd, w), std::runtime_error);
+
+    // a corrupt count is caught from the file size, before allocating
+    std::uint64_t count = std::uint64_t(1) << 60;
+    REQUIRE(pwrite(file.fd, &count, sizeof(count), offsetof(VectorFileHeader, count)) == sizeof(count));
+    lseek(file.fd, 0, SEEK_SET);
+    REQUIRE_THROWS_AS(load(file.fd, w), std::runtime_error);
+
+    REQUIRE_THROWS_AS(load(-1, w), std::system_error);
+}
+
+TEST_CASE ("crc32cKnownValue") {
+    REQUIRE(crc32c("123456789", 9) == 0xE3069283u);
+    REQUIRE(crc32c_table(reinterpret_cast<const unsigned char*>("123456789"), 9, ~0u) == ~0xE3069283u);
+    REQUIRE(crc32c("56789", 5, crc32c("1234", 4)) == 0xE3069283u);
+}
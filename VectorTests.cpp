@@ -1,6 +1,9 @@
 #include "catch.hpp"
 #include "Vector.hpp"
 #include <iostream>
+#include <string>
+#include <sstream>
+#include <list>
 
 namespace {
     template <typename C>
@@ -63,3 +66,413 @@ TEST_CASE ("constructWithInitializerList") {
     REQUIRE(v.size() == 3);
     print_vec(v);
 }
+
+TEST_CASE ("pushBackGrowsGeometrically") {
+    Vector<int> v;
+
+    for (int i=0; i!=100; ++i)
+        v.push_back(i);
+
+    REQUIRE(v.size() == 100);
+    REQUIRE(v.capacity() == 128);
+    REQUIRE(*(v.begin()+99) == 99);
+}
+
+namespace {
+    // user-defined policy: grow by a fixed chunk
+    struct ChunkGrowth {
+        template <typename S>
+        static S next_capacity(S cap, S required) {
+            return std::max(cap+16, required);
+        }
+    };
+}
+
+TEST_CASE ("customGrowthPolicies") {
+    Vector<int, std::allocator<int>, OneAndHalfGrowth> a;
+    Vector<int, std::allocator<int>, GoldenRatioGrowth> b;
+    Vector<int, std::allocator<int>, ChunkGrowth> c;
+
+    for (int i=0; i!=50; ++i) {
+        a.push_back(i);
+        b.push_back(i);
+        c.push_back(i);
+    }
+
+    REQUIRE(a.size() == 50);
+    REQUIRE(b.size() == 50);
+    REQUIRE(c.size() == 50);
+    REQUIRE(c.capacity() == 64);
+
+    REQUIRE(OneAndHalfGrowth::next_capacity(std::size_t(10), std::size_t(11)) == 15);
+    REQUIRE(GoldenRatioGrowth::next_capacity(std::size_t(1000), std::size_t(1001)) == 1618);
+    REQUIRE(DoublingGrowth::next_capacity(std::size_t(0), std::size_t(1)) == 1);
+}
+
+TEST_CASE ("emplaceAndMoveOnlyElements") {
+    Vector<std::unique_ptr<int>> v;
+
+    for (int i=0; i!=20; ++i)
+        v.emplace_back(new int{i});
+
+    auto p = std::make_unique<int>(20);
+    v.push_back(std::move(p));
+
+    REQUIRE(v.size() == 21);
+    REQUIRE_FALSE(p);
+    REQUIRE(**(v.begin()+20) == 20);
+
+    Vector<std::unique_ptr<int>> w{std::move(v)};
+    REQUIRE(w.size() == 21);
+    REQUIRE(v.empty());
+
+    w.resize(30);
+    REQUIRE(w.size() == 30);
+    REQUIRE_FALSE(*(w.begin()+25));
+    REQUIRE(**(w.begin()+5) == 5);
+}
+
+TEST_CASE ("pushBackOwnElement") {
+    Vector<std::string> v = {"a long string that is not stored inline"};
+
+    // forces a reallocation while referring to an existing element
+    for (int i=0; i!=10; ++i)
+        v.push_back(*v.begin());
+
+    REQUIRE(v.size() == 11);
+    for (const auto& s : v)
+        REQUIRE(s == *v.begin());
+}
+
+namespace {
+    // owning handle that opts into memcpy relocation
+    struct Handle {
+        explicit Handle(int v): p{new int{v}} {}
+        Handle(Handle&& h): p{h.p} { h.p = nullptr; ++moves; }
+        ~Handle() { delete p; }
+
+        int* p;
+        static int moves;
+    };
+
+    int Handle::moves = 0;
+}
+
+namespace tutorial {
+    template <>
+    struct is_trivially_relocatable<Handle> : std::true_type {};
+}
+
+TEST_CASE ("trivialRelocation") {
+    static_assert(is_trivially_relocatable_v<double>, "");
+    static_assert(!is_trivially_relocatable_v<std::string>, "");
+
+    Vector<Handle> v;
+    for (int i=0; i!=100; ++i)
+        v.emplace_back(i);
+
+    // reallocations relocate by memcpy, never through the move constructor
+    REQUIRE(Handle::moves == 0);
+    REQUIRE(v.size() == 100);
+    REQUIRE(*(v.begin()+42)->p == 42);
+
+    v.reserve(1000);
+    REQUIRE(Handle::moves == 0);
+    REQUIRE(*(v.begin()+99)->p == 99);
+}
+
+namespace {
+    // bump allocator over a fixed buffer that can extend its last block
+    template <typename T>
+    struct TestBumpAllocator {
+        using value_type = T;
+        using size_type = std::size_t;
+
+        T* allocate(size_type n) {
+            T* p = buf+used;
+            used += n;
+            ++allocations;
+            return p;
+        }
+
+        void deallocate(T*, size_type) {}
+
+        bool try_expand(T* p, size_type old_n, size_type new_n) {
+            if (p+old_n!=buf+used || p+new_n>buf+256) return false;
+            used += new_n-old_n;
+            return true;
+        }
+
+        static T buf[256];
+        static size_type used;
+        static int allocations;
+    };
+
+    template <typename T> T TestBumpAllocator<T>::buf[256];
+    template <typename T> std::size_t TestBumpAllocator<T>::used = 0;
+    template <typename T> int TestBumpAllocator<T>::allocations = 0;
+}
+
+TEST_CASE ("expandInPlace") {
+    static_assert(has_try_expand_v<TestBumpAllocator<int>>, "");
+    static_assert(!has_try_expand_v<std::allocator<int>>, "");
+
+    Vector<int, TestBumpAllocator<int>> v;
+    for (int i=0; i!=100; ++i)
+        v.push_back(i);
+
+    // the tail block is extended, no new block is ever carved out
+    REQUIRE(TestBumpAllocator<int>::allocations == 1);
+    REQUIRE(v.size() == 100);
+    REQUIRE(*(v.begin()+99) == 99);
+    REQUIRE(v.begin() == TestBumpAllocator<int>::buf);
+}
+
+TEST_CASE ("bulkAppendAndInsert") {
+    Vector<int> v = {1, 2, 3};
+    int more[] = {4, 5, 6, 7, 8};
+
+    v.append(more, more+5);
+    REQUIRE(v.size() == 8);
+    REQUIRE(v.capacity() == 8);
+
+    auto it = v.insert(v.begin()+1, 3, 0);
+    REQUIRE(it == v.begin()+1);
+    REQUIRE(v.size() == 11);
+
+    int expected[] = {1, 0, 0, 0, 2, 3, 4, 5, 6, 7, 8};
+    REQUIRE(std::equal(v.begin(), v.end(), expected));
+
+    // inserting a range of the vector into itself
+    v.insert(v.begin(), v.begin()+4, v.begin()+6);
+    REQUIRE(v.size() == 13);
+    REQUIRE(*v.begin() == 2);
+    REQUIRE(*(v.begin()+1) == 3);
+    REQUIRE(*(v.begin()+2) == 1);
+}
+
+TEST_CASE ("insertNonTrivialElements") {
+    Vector<std::string> v = {"a", "d"};
+    v.reserve(10);
+
+    std::string mid[] = {"b", "c"};
+    v.insert(v.begin()+1, mid, mid+2);
+
+    // within capacity, then through a reallocation
+    v.insert(v.end(), 2, *v.begin());
+    v.insert(v.begin(), 8, "z");
+
+    REQUIRE(v.size() == 14);
+    REQUIRE(*(v.begin()+8) == "a");
+    REQUIRE(*(v.begin()+11) == "d");
+    REQUIRE(*(v.begin()+13) == "a");
+
+    std::istringstream in{"x y"};
+    v.insert(v.begin()+8, std::istream_iterator<std::string>{in}, std::istream_iterator<std::string>{});
+    REQUIRE(v.size() == 16);
+    REQUIRE(*(v.begin()+9) == "y");
+    REQUIRE(*(v.begin()+10) == "a");
+
+    // ranges of another element type
+    const char* words[] = {"p", "q"};
+    v.append(words, words+2);
+    REQUIRE(v.size() == 18);
+    REQUIRE(*(v.begin()+17) == "q");
+
+    Vector<long> w = {1};
+    short shorts[] = {2, 3};
+    w.insert(w.begin(), shorts, shorts+2);
+    REQUIRE(w.size() == 3);
+    REQUIRE(*w.begin() == 2);
+    REQUIRE(*(w.begin()+2) == 1);
+}
+
+TEST_CASE ("defaultInitialization") {
+    Vector<float> v(1000, default_init);
+    REQUIRE(v.size() == 1000);
+
+    std::fill(v.begin(), v.end(), 1.5f);
+
+    v.resize_default_init(2000);
+    REQUIRE(v.size() == 2000);
+    REQUIRE(*(v.begin()+999) == 1.5f);
+
+    // non-trivial types are still default constructed
+    Vector<std::string> s(3, default_init);
+    s.resize_default_init(5);
+    REQUIRE(s.size() == 5);
+    REQUIRE((s.begin()+4)->empty());
+
+    s.resize_default_init(1);
+    REQUIRE(s.size() == 1);
+}
+
+TEST_CASE ("constructFromIterators") {
+    std::istringstream in{"1 2 3 4 5 6 7 8 9 10"};
+    Vector<int> a(std::istream_iterator<int>{in}, std::istream_iterator<int>{});
+
+    REQUIRE(a.size() == 10);
+    REQUIRE(*(a.begin()+9) == 10);
+
+    std::istringstream in2{"1 2 3"};
+    Vector<int> b(std::istream_iterator<int>{in2}, std::istream_iterator<int>{}, 64);
+    REQUIRE(b.size() == 3);
+    REQUIRE(b.capacity() == 64);
+
+    std::list<std::string> l = {"a", "b", "c"};
+    Vector<std::string> c(l.begin(), l.end());
+    REQUIRE(c.size() == 3);
+    REQUIRE(c.capacity() == 3);
+    REQUIRE(*(c.begin()+2) == "c");
+
+    Vector<int> d(a.begin(), a.end());
+    REQUIRE(std::equal(d.begin(), d.end(), a.begin()));
+
+    // not mistaken for an iterator range
+    Vector<int> e(10, 5);
+    REQUIRE(e.size() == 10);
+    REQUIRE(*e.begin() == 5);
+}
+
+TEST_CASE ("copyAssignmentReusesStorage") {
+    Vector<std::string> a = {"a", "b"};
+    a.reserve(10);
+    const std::string* storage = a.begin();
+
+    Vector<std::string> b = {"w", "x", "y", "z"};
+    a = b;
+    REQUIRE(a.size() == 4);
+    REQUIRE(a.begin() == storage);
+    REQUIRE(*(a.begin()+3) == "z");
+
+    Vector<std::string> c = {"q"};
+    a = c;
+    REQUIRE(a.size() == 1);
+    REQUIRE(*a.begin() == "q");
+
+    Vector<int> x(100, 1);
+    Vector<int> y(50, 2);
+    const int* ints = x.begin();
+    x = y;
+    REQUIRE(x.size() == 50);
+    REQUIRE(x.begin() == ints);
+    REQUIRE(*(x.begin()+49) == 2);
+
+    y = Vector<int>(200, 3);
+    x = y;
+    REQUIRE(x.size() == 200);
+    REQUIRE(*(x.begin()+199) == 3);
+}
+
+TEST_CASE ("pmrVector") {
+    char buffer[4096];
+    std::pmr::monotonic_buffer_resource arena{buffer, sizeof(buffer), std::pmr::null_memory_resource()};
+
+    tutorial::pmr::Vector<int> v{&arena};
+    for (int i=0; i!=100; ++i)
+        v.push_back(i);
+
+    REQUIRE(v.size() == 100);
+    REQUIRE(v.get_allocator().resource() == &arena);
+    REQUIRE(static_cast<void*>(v.begin()) >= static_cast<void*>(buffer));
+    REQUIRE(static_cast<void*>(v.begin()) < static_cast<void*>(buffer+sizeof(buffer)));
+
+    // copies don't inherit the resource, moves do
+    tutorial::pmr::Vector<int> copy{v};
+    REQUIRE(copy.get_allocator().resource() == std::pmr::get_default_resource());
+
+    tutorial::pmr::Vector<int> moved{std::move(copy)};
+    REQUIRE(moved.get_allocator().resource() == std::pmr::get_default_resource());
+    REQUIRE(moved.size() == 100);
+
+    // move assignment across resources moves the elements
+    v = std::move(moved);
+    REQUIRE(v.get_allocator().resource() == &arena);
+    REQUIRE(v.size() == 100);
+    REQUIRE(*(v.begin()+99) == 99);
+
+    tutorial::pmr::Vector<int> w{&arena};
+    w.push_back(42);
+    swap(v, w);
+    REQUIRE(v.size() == 1);
+    REQUIRE(w.size() == 100);
+
+    v = w;
+    REQUIRE(v.get_allocator().resource() == &arena);
+    REQUIRE(v.size() == 100);
+}
+
+TEST_CASE ("pmrVectorOfPmrStrings") {
+    std::pmr::unsynchronized_pool_resource pool;
+    const std::pmr::string text{"a string too long for the small string buffer"};
+
+    // elements are built with the vector's resource, however they got in
+    tutorial::pmr::Vector<std::pmr::string> v{&pool};
+    v.push_back(text);
+    v.emplace_back(text);
+    v.resize(4, text);
+    v.resize(6);
+    v.insert(v.begin()+1, 2, text);
+    v.append(&text, &text+1);
+
+    REQUIRE(v.size() == 9);
+    REQUIRE(*(v.begin()+8) == text);
+    REQUIRE(std::all_of(v.begin(), v.end(), [&](const std::pmr::string& x) {
+        return x.get_allocator().resource() == &pool;
+    }));
+
+    // a copy uses its own resource for its elements too
+    tutorial::pmr::Vector<std::pmr::string> copy{v};
+    REQUIRE(copy.begin()->get_allocator().resource() == std::pmr::get_default_resource());
+}
+
+namespace {
+    // lowers the streaming store threshold for the rest of the scope
+    struct StreamingThreshold {
+        explicit StreamingThreshold(std::size_t bytes): saved{streaming_store_threshold} {
+            streaming_store_threshold = bytes;
+        }
+
+        ~StreamingThreshold() {
+            streaming_store_threshold = saved;
+        }
+
+        std::size_t saved;
+    };
+}
+
+TEST_CASE ("streamingFillAndCopy") {
+    StreamingThreshold threshold{1024};
+
+    Vector<double> v(100000, 2.5);
+    REQUIRE(std::all_of(v.begin(), v.end(), [](double x) { return x == 2.5; }));
+
+    Vector<double> c{v};
+    REQUIRE(std::equal(c.begin(), c.end(), v.begin()));
+
+    // misaligned source and destination, odd length
+    Vector<char> bytes(5000, 'a');
+    Vector<char> tail(bytes.begin()+3, bytes.end()-2);
+    REQUIRE(tail.size() == 4995);
+    REQUIRE(std::all_of(tail.begin(), tail.end(), [](char x) { return x == 'a'; }));
+
+    tail.resize(20000, 'b');
+    REQUIRE(*(tail.begin()+4994) == 'a');
+    REQUIRE(std::all_of(tail.begin()+4995, tail.end(), [](char x) { return x == 'b'; }));
+}
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+TEST_CASE ("streamingFillSse2RepeatsWholePattern") {
+    // 32 byte elements fill with a 32 byte pattern, not its first half twice
+    struct Quad { std::uint64_t x[4]; };
+    Quad val{{1, 2, 3, 4}};
+
+    alignas(32) Quad buf[64];
+    stream_fill_sse2(reinterpret_cast<char*>(buf), reinterpret_cast<const char*>(&val), sizeof(buf));
+    _mm_sfence();
+
+    REQUIRE(std::all_of(std::begin(buf), std::end(buf), [](const Quad& q) {
+        return q.x[0] == 1 && q.x[1] == 2 && q.x[2] == 3 && q.x[3] == 4;
+    }));
+}
+#endif
@@ -0,0 +1,48 @@
+// worst-case push_back latency as the container grows: Vector stalls
+// while it copies everything on each doubling, SegmentedVector does not.
+// Usage: AppendLatencyBench [count]   (default 64M)
+#include "../Vector.hpp"
+#include "../SegmentedVector.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+using namespace tutorial;
+
+namespace {
+    template <typename V>
+    void run(const char* name, std::size_t n) {
+        using clock = std::chrono::steady_clock;
+
+        std::vector<float> latency(n);
+
+        V v;
+        auto start = clock::now();
+        for (std::size_t i=0; i!=n; ++i) {
+            auto t = clock::now();
+            v.push_back(i);
+            latency[i] = std::chrono::duration<float, std::nano>(clock::now()-t).count();
+        }
+        double total_ms = std::chrono::duration<double, std::milli>(clock::now()-start).count();
+
+        auto pct = [&](double p) {
+            auto it = latency.begin()+static_cast<std::size_t>(p*(n-1));
+            std::nth_element(latency.begin(), it, latency.end());
+            return *it;
+        };
+
+        std::printf("%-16s total %8.1f ms   p50 %6.0f ns   p99.99 %8.0f ns   max %10.0f ns\n",
+                    name, total_ms, pct(0.5), pct(0.9999),
+                    *std::max_element(latency.begin(), latency.end()));
+    }
+}
+
+int main(int argc, char** argv) {
+    std::size_t n = argc>1 ? std::strtoul(argv[1], nullptr, 10) : std::size_t(64) << 20;
+
+    run<Vector<std::uint64_t>>("Vector", n);
+    run<SegmentedVector<std::uint64_t>>("SegmentedVector", n);
+}
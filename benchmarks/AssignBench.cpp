@@ -0,0 +1,39 @@
+// Copy assignment into existing capacity versus copy-and-swap.
+#include "../Vector.hpp"
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+using namespace tutorial;
+
+namespace {
+    using clock = std::chrono::steady_clock;
+
+    template <typename T>
+    void run(const char* name, const T& val, std::size_t n, int iterations) {
+        Vector<T> src(n, val);
+        Vector<T> dst(n, val);
+
+        auto start = clock::now();
+        for (int i=0; i!=iterations; ++i)
+            dst = src;
+        double assign = std::chrono::duration<double, std::micro>(clock::now()-start).count();
+
+        start = clock::now();
+        for (int i=0; i!=iterations; ++i) {
+            Vector<T> tmp{src};
+            dst = std::move(tmp);
+        }
+        double swap = std::chrono::duration<double, std::micro>(clock::now()-start).count();
+
+        std::printf("%-8s n=%-9zu assign %10.1f us   copy-and-swap %10.1f us\n",
+                    name, n, assign/iterations, swap/iterations);
+    }
+}
+
+int main() {
+    for (std::size_t n : {1000u, 100000u, 1000000u}) {
+        run<double>("double", 1.0, n, 200);
+        run<std::string>("string", std::string(32, 'x'), n, 20);
+    }
+}
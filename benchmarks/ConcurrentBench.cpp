@@ -0,0 +1,88 @@
+// throughput of many threads appending to one shared vector: a Vector
+// behind a mutex against ConcurrentVector, one push_back at a time and in
+// batches of 1000 reserved slots, from 1 to 64 threads.
+// Usage: ConcurrentBench [count]   (total pushes per run, default 16M)
+#include "../Vector.hpp"
+#include "../ConcurrentVector.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace tutorial;
+
+namespace {
+    struct LockedVector {
+        void push_back(std::uint64_t x) {
+            std::lock_guard<std::mutex> lock{m};
+            v.push_back(x);
+        }
+
+        std::mutex m;
+        Vector<std::uint64_t> v;
+    };
+
+    template <typename V>
+    double run(int threads, std::size_t n) {
+        using clock = std::chrono::steady_clock;
+
+        V v;
+        std::vector<std::thread> pool;
+
+        auto start = clock::now();
+        for (int t=0; t!=threads; ++t) {
+            pool.emplace_back([&v, t, threads, n] {
+                for (std::size_t i=t; i<n; i+=threads)
+                    v.push_back(i);
+            });
+        }
+        for (auto& th : pool)
+            th.join();
+
+        double s = std::chrono::duration<double>(clock::now()-start).count();
+        return n/s/1e6;
+    }
+
+    double run_batched(int threads, std::size_t n) {
+        using clock = std::chrono::steady_clock;
+        static constexpr std::size_t batch = 1000;
+
+        ConcurrentVector<std::uint64_t> v;
+        std::vector<std::thread> pool;
+
+        auto start = clock::now();
+        for (int t=0; t!=threads; ++t) {
+            pool.emplace_back([&v, t, threads, n] {
+                for (std::size_t i=t*batch; i<n; i+=threads*batch) {
+                    auto r = v.reserve_slots(std::min(batch, n-i));
+                    r.for_each_segment([&](std::uint64_t* p, std::size_t count, std::size_t j) {
+                        for (std::size_t x=0; x!=count; ++x)
+                            p[x] = i+j+x;
+                    });
+                    v.commit(r);
+                }
+            });
+        }
+        for (auto& th : pool)
+            th.join();
+
+        double s = std::chrono::duration<double>(clock::now()-start).count();
+        return n/s/1e6;
+    }
+}
+
+int main(int argc, char** argv) {
+    std::size_t n = argc>1 ? std::strtoul(argv[1], nullptr, 10) : std::size_t(16) << 20;
+
+    std::printf("%8s %16s %16s %16s   (million pushes/s)\n", "threads", "mutex+Vector", "ConcurrentVector", "batched");
+    for (int threads=1; threads<=64; threads*=2) {
+        std::printf("%8d %16.1f %16.1f %16.1f\n", threads,
+                    run<LockedVector>(threads, n),
+                    run<ConcurrentVector<std::uint64_t>>(threads, n),
+                    run_batched(threads, n));
+    }
+}
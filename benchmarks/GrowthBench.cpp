@@ -0,0 +1,30 @@
+// Amortized cost of push_back for each growth policy.
+#include "../Vector.hpp"
+#include <chrono>
+#include <cstdio>
+
+using namespace tutorial;
+
+namespace {
+    template <typename G>
+    void run(const char* name, std::size_t n) {
+        using clock = std::chrono::steady_clock;
+
+        auto start = clock::now();
+        Vector<int, std::allocator<int>, G> v;
+        for (std::size_t i=0; i!=n; ++i)
+            v.push_back(static_cast<int>(i));
+        auto elapsed = std::chrono::duration<double, std::nano>(clock::now()-start).count();
+
+        std::printf("%-12s n=%-10zu %8.2f ns/push_back  capacity=%zu\n",
+                    name, n, elapsed/n, static_cast<std::size_t>(v.capacity()));
+    }
+}
+
+int main() {
+    for (std::size_t n : {1000u, 100000u, 10000000u}) {
+        run<DoublingGrowth>("2x", n);
+        run<OneAndHalfGrowth>("1.5x", n);
+        run<GoldenRatioGrowth>("golden", n);
+    }
+}
@@ -0,0 +1,88 @@
+// Random access into a large vector with regular versus huge pages.
+// Reports dTLB load misses when hardware counters are available.
+// Usage: HugePageBench [size_mb]   (default 4096)
+#include "../Vector.hpp"
+#include "../HugePageAllocator.hpp"
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+using namespace tutorial;
+
+namespace {
+    // counts dTLB read misses of this thread, or does nothing if the
+    // kernel doesn't let us open the counter
+    struct TlbCounter {
+        TlbCounter() {
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.type = PERF_TYPE_HW_CACHE;
+            attr.config = PERF_COUNT_HW_CACHE_DTLB |
+                          (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                          (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+            attr.disabled = 1;
+            attr.exclude_kernel = 1;
+            fd = syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+        }
+
+        ~TlbCounter() { if (fd>=0) close(fd); }
+
+        void start() {
+            if (fd<0) return;
+            ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+
+        long long stop() {
+            if (fd<0) return -1;
+            ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+            long long count = 0;
+            if (read(fd, &count, sizeof(count))!=sizeof(count)) return -1;
+            return count;
+        }
+
+        int fd;
+    };
+
+    template <typename A>
+    void run(const char* name, std::size_t n, std::size_t lookups) {
+        using clock = std::chrono::steady_clock;
+
+        Vector<std::uint64_t, A> v(n, 1);
+        std::uint64_t x = 88172645463325252ull, sum = 0;
+
+        TlbCounter tlb;
+        auto start = clock::now();
+        tlb.start();
+        for (std::size_t i=0; i!=lookups; ++i) {
+            // xorshift, cheap enough not to hide the memory latency
+            x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+            sum += *(v.begin()+x%n);
+        }
+        long long misses = tlb.stop();
+        double ns = std::chrono::duration<double, std::nano>(clock::now()-start).count();
+
+        if (misses>=0)
+            std::printf("%-10s %8.2f ns/lookup  %12lld dTLB misses  (sum %llu)\n",
+                        name, ns/lookups, misses, static_cast<unsigned long long>(sum));
+        else
+            std::printf("%-10s %8.2f ns/lookup  dTLB counter unavailable  (sum %llu)\n",
+                        name, ns/lookups, static_cast<unsigned long long>(sum));
+    }
+}
+
+int main(int argc, char** argv) {
+    std::size_t mb = argc>1 ? std::strtoul(argv[1], nullptr, 10) : 4096;
+    std::size_t n = (mb << 20) / sizeof(std::uint64_t);
+    const std::size_t lookups = 20000000;
+
+    run<std::allocator<std::uint64_t>>("regular", n, lookups);
+    run<HugePageAllocator<std::uint64_t>>("huge", n, lookups);
+}
@@ -0,0 +1,48 @@
+// histogram of push_back latencies for Vector and IncrementalVector. The
+// worst Vector push_back moves every element; the worst IncrementalVector
+// push_back moves K of them.
+// Usage: IncrementalBench [count]   (default 64M)
+#include "../Vector.hpp"
+#include "../IncrementalVector.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+using namespace tutorial;
+
+namespace {
+    template <typename V>
+    void run(const char* name, std::size_t n) {
+        using clock = std::chrono::steady_clock;
+
+        // bucket b counts latencies in [2^b, 2^(b+1)) ns
+        std::size_t hist[40] = {};
+        std::int64_t worst = 0;
+
+        V v;
+        for (std::size_t i=0; i!=n; ++i) {
+            auto t = clock::now();
+            v.push_back(i);
+            std::int64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now()-t).count();
+
+            worst = std::max(worst, ns);
+            ++hist[ns>0 ? 63-__builtin_clzll(ns) : 0];
+        }
+
+        std::printf("%s: max %lld ns\n", name, static_cast<long long>(worst));
+        for (int b=0; b!=40; ++b) {
+            if (hist[b])
+                std::printf("  %12llu ns  %10zu\n", 1ull << b, hist[b]);
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    std::size_t n = argc>1 ? std::strtoul(argv[1], nullptr, 10) : std::size_t(64) << 20;
+
+    run<Vector<std::uint64_t>>("Vector", n);
+    run<IncrementalVector<std::uint64_t, std::allocator<std::uint64_t>, 4>>("IncrementalVector K=4", n);
+    run<IncrementalVector<std::uint64_t, std::allocator<std::uint64_t>, 64>>("IncrementalVector K=64", n);
+}
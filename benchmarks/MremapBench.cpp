@@ -0,0 +1,35 @@
+// Cost of a single doubling of a large buffer: mremap versus allocate+copy.
+// Usage: MremapBench [max_mb]   (default 4096)
+#include "../Vector.hpp"
+#include "../MmapAllocator.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+using namespace tutorial;
+
+namespace {
+    template <typename A>
+    double time_growth(std::size_t bytes) {
+        using clock = std::chrono::steady_clock;
+
+        Vector<char, A> v;
+        v.resize(bytes, 'x');
+
+        auto start = clock::now();
+        v.reserve(2*bytes);
+        return std::chrono::duration<double, std::micro>(clock::now()-start).count();
+    }
+}
+
+int main(int argc, char** argv) {
+    std::size_t max_mb = argc>1 ? std::strtoul(argv[1], nullptr, 10) : 4096;
+
+    std::printf("%10s %14s %14s\n", "size (MB)", "copy (us)", "mremap (us)");
+    for (std::size_t mb=1; mb<=max_mb; mb*=2) {
+        std::size_t bytes = mb << 20;
+        double copy = time_growth<std::allocator<char>>(bytes);
+        double remap = time_growth<MmapAllocator<char>>(bytes);
+        std::printf("%10zu %14.1f %14.1f\n", mb, copy, remap);
+    }
+}
@@ -0,0 +1,52 @@
+// push_back latency into freshly reserved capacity, with and without
+// prefaulting the capacity in reserve.
+// Usage: PrefaultBench [size_mb]   (default 256)
+#include "../Vector.hpp"
+#include "../MmapAllocator.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+using namespace tutorial;
+
+namespace {
+    template <typename A>
+    void run(const char* name, std::size_t n) {
+        using clock = std::chrono::steady_clock;
+
+        std::vector<float> latency(n);
+
+        auto start = clock::now();
+        Vector<std::uint64_t, A> v;
+        v.reserve(n);
+        double reserve_ms = std::chrono::duration<double, std::milli>(clock::now()-start).count();
+
+        for (std::size_t i=0; i!=n; ++i) {
+            auto t = clock::now();
+            v.push_back(i);
+            latency[i] = std::chrono::duration<float, std::nano>(clock::now()-t).count();
+        }
+
+        auto pct = [&](double p) {
+            auto it = latency.begin()+static_cast<std::size_t>(p*(n-1));
+            std::nth_element(latency.begin(), it, latency.end());
+            return *it;
+        };
+
+        std::printf("%-12s reserve %8.1f ms   p50 %6.0f ns   p99 %6.0f ns   p99.9 %6.0f ns   max %8.0f ns\n",
+                    name, reserve_ms, pct(0.5), pct(0.99), pct(0.999),
+                    *std::max_element(latency.begin(), latency.end()));
+    }
+}
+
+int main(int argc, char** argv) {
+    std::size_t mb = argc>1 ? std::strtoul(argv[1], nullptr, 10) : 256;
+    std::size_t n = (mb << 20) / sizeof(std::uint64_t);
+
+    run<MmapAllocator<std::uint64_t>>("lazy", n);
+    run<PrefaultedAllocator<std::uint64_t>>("prefaulted", n);
+    run<LockedAllocator<std::uint64_t>>("locked", n);
+}
@@ -0,0 +1,53 @@
+// Throughput of short-lived vectors with RecyclingAllocator versus
+// std::allocator, for an increasing number of threads.
+// Usage: RecyclerBench [max_threads]   (default 64)
+#include "../RecyclingAllocator.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+using namespace tutorial;
+
+namespace {
+    std::atomic<long> sink{0};
+
+    template <typename A>
+    void work(int iterations) {
+        long sum = 0;
+        for (int i=0; i!=iterations; ++i) {
+            Vector<int, A> v(16 << (i%8), i);
+            sum += *v.begin();
+        }
+        sink += sum;
+    }
+
+    template <typename A>
+    double run(int threads, int iterations) {
+        using clock = std::chrono::steady_clock;
+
+        auto start = clock::now();
+        std::vector<std::thread> workers;
+        for (int t=0; t!=threads; ++t)
+            workers.emplace_back(work<A>, iterations);
+        for (auto& w : workers)
+            w.join();
+        double seconds = std::chrono::duration<double>(clock::now()-start).count();
+
+        return threads*iterations/seconds;
+    }
+}
+
+int main(int argc, char** argv) {
+    int max_threads = argc>1 ? std::atoi(argv[1]) : 64;
+    const int iterations = 200000;
+
+    std::printf("%8s %20s %20s\n", "threads", "std (vectors/s)", "recycling (vectors/s)");
+    for (int t=1; t<=max_threads; t*=2) {
+        double plain = run<std::allocator<int>>(t, iterations);
+        double recycled = run<RecyclingAllocator<int>>(t, iterations);
+        std::printf("%8d %20.0f %20.0f\n", t, plain, recycled);
+    }
+}
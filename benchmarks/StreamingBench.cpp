@@ -0,0 +1,64 @@
+// Cache pollution of large fills and copies. A second thread keeps reading
+// a cache-sized working set while the main thread builds and copies a big
+// Vector<double>, once with regular stores and once with streaming stores.
+// Usage: StreamingBench [size_mb]   (default 2048)
+#include "../Vector.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+using namespace tutorial;
+
+namespace {
+    using clock = std::chrono::steady_clock;
+
+    // random reads over a working set that fits in the cache
+    void reader(const std::atomic<bool>& stop, std::atomic<std::uint64_t>& reads) {
+        std::vector<std::uint64_t> set((std::size_t(4) << 20) / sizeof(std::uint64_t), 1);
+        std::uint64_t x = 88172645463325252ull, sum = 0, n = 0;
+
+        while (!stop.load(std::memory_order_relaxed)) {
+            for (int i=0; i!=4096; ++i) {
+                x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+                sum += set[x%set.size()];
+            }
+            n += 4096;
+        }
+
+        reads = n + (sum==0);
+    }
+
+    void run(const char* name, std::size_t threshold, std::size_t n) {
+        streaming_store_threshold = threshold;
+
+        std::atomic<bool> stop{false};
+        std::atomic<std::uint64_t> reads{0};
+        std::thread t{reader, std::cref(stop), std::ref(reads)};
+
+        auto start = clock::now();
+        {
+            Vector<double> v(n, 1.0);
+            Vector<double> c{v};
+            if (*(c.end()-1) != 1.0) std::puts("bad copy");
+        }
+        double seconds = std::chrono::duration<double>(clock::now()-start).count();
+
+        stop = true;
+        t.join();
+
+        std::printf("%-10s fill+copy %8.1f ms   concurrent reads %8.1f M/s\n",
+                    name, seconds*1e3, reads/seconds/1e6);
+    }
+}
+
+int main(int argc, char** argv) {
+    std::size_t mb = argc>1 ? std::strtoul(argv[1], nullptr, 10) : 2048;
+    std::size_t n = (mb << 20) / sizeof(double);
+
+    run("regular", SIZE_MAX, n);
+    run("streaming", 0, n);
+}